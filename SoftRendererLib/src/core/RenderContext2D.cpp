@@ -24,15 +24,29 @@ Texture * RenderContext2D::GetTargetTexture()
     return targetTexture;
 }
 
+Texture *RenderContext2D::GetDrawTarget()
+{
+    // renderers address the target row by row, tiled storage would be scrambled
+    if (!targetTexture || targetTexture->GetLayout() != TextureLayout::LINEAR)
+        return nullptr;
+    targetTexture->MarkModified();
+    return targetTexture;
+}
+
 
 
 BlendMode Tergos2D::RenderContext2D::BlendModeToUse(const PixelFormatInfo &info)
+{
+    return BlendModeToUse(info, GetColoring());
+}
+
+BlendMode Tergos2D::RenderContext2D::BlendModeToUse(const PixelFormatInfo &info, const Coloring &coloring)
 {
     BlendMode touse = m_BlendContext.mode;
 
     if(touse == BlendMode::NOBLEND) return touse;
-    if(!info.hasAlpha && !GetColoring().colorEnabled) return BlendMode::NOBLEND;
-    if(!info.hasAlpha && GetColoring().colorEnabled) return BlendMode::COLORINGONLY;
+    if(!info.hasAlpha && !coloring.colorEnabled) return BlendMode::NOBLEND;
+    if(!info.hasAlpha && coloring.colorEnabled) return BlendMode::COLORINGONLY;
 
     return touse;
 }
@@ -47,10 +61,20 @@ SamplingMethod Tergos2D::RenderContext2D::GetSamplingMethod()
     return samplingMethod;
 }
 
+void Tergos2D::RenderContext2D::EnableEdgeAntialiasing(bool antialiasing)
+{
+    this->edgeAntialiasing = antialiasing;
+}
+
+bool Tergos2D::RenderContext2D::IsEdgeAntialiasingEnabled()
+{
+    return edgeAntialiasing;
+}
+
 
 void RenderContext2D::ClearTarget(Color color)
 {
-    if (targetTexture == nullptr)
+    if (GetDrawTarget() == nullptr)
     {
         return;
     }
@@ -59,9 +83,9 @@ void RenderContext2D::ClearTarget(Color color)
     PixelFormatInfo info = PixelFormatRegistry::GetInfo(format);
 
     uint8_t *textureData = targetTexture->GetData();
-    uint16_t width = targetTexture->GetWidth();
-    uint16_t height = targetTexture->GetHeight();
-    uint32_t pitch = targetTexture->GetPitch();
+    uint32_t width = targetTexture->GetWidth();
+    uint32_t height = targetTexture->GetHeight();
+    size_t pitch = targetTexture->GetPitch();
 
     uint8_t pixelData[4];
     color.ConvertTo(format, pixelData);
@@ -89,7 +113,7 @@ bool Tergos2D::RenderContext2D::IsClippingEnabled()
 {
     return enableClipping;
 }
-void RenderContext2D::SetClipping(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY)
+void RenderContext2D::SetClipping(int32_t startX, int32_t startY, int32_t endX, int32_t endY)
 {
     this->clippingArea.startX = startX;
     this->clippingArea.startY = startY;
@@ -132,3 +156,23 @@ void Tergos2D::RenderContext2D::SetBlendContext(BlendContext context)
 {
     this->m_BlendContext = context;
 }
+
+void Tergos2D::RenderContext2D::SetConversionCache(ConvertedTextureCache *cache)
+{
+    conversionCache = cache;
+}
+
+ConvertedTextureCache *Tergos2D::RenderContext2D::GetConversionCache()
+{
+    return conversionCache;
+}
+
+void Tergos2D::RenderContext2D::SetScalingCache(ScaledTextureCache *cache)
+{
+    scalingCache = cache;
+}
+
+ScaledTextureCache *Tergos2D::RenderContext2D::GetScalingCache()
+{
+    return scalingCache;
+}
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include "../data/Texture.h"
+#include "../data/ConvertedTextureCache.h"
+#include "../data/ScaledTextureCache.h"
 #include "../data/Color.h"
 #include "../data/BlendMode/BlendMode.h"
 #include "../data/BlendMode/BlendFunctions.h"
@@ -21,11 +23,14 @@ namespace Tergos2D
     enum class SamplingMethod
     {
         NEAREST,
-        LINEAR
+        LINEAR,
+        // averages every source pixel covered by a target pixel, used for downscaling.
+        // renderers without a dedicated area filter fall back to LINEAR
+        AREA
     };
 
     struct ClippingArea{
-        int16_t startX, startY, endX, endY;
+        int32_t startX, startY, endX, endY;
     };
 
     class RenderContext2D
@@ -42,20 +47,33 @@ namespace Tergos2D
 
 
 
+        /// @brief Sets the texture draws and ClearTarget write to. It has to be in TextureLayout::LINEAR,
+        /// convert tiled textures with Texture::ConvertLayout first, draws into other layouts do nothing
         void SetTargetTexture(Texture *targetTexture);
         Texture* GetTargetTexture();
+        /// @brief Target of a draw that is about to change its pixels, marks it modified so caches drop
+        /// data derived from its old content. Renderers fetch their target through this
+        /// @return nullptr if no target is set or it is not in TextureLayout::LINEAR, draws into it are skipped
+        Texture* GetDrawTarget();
 
         //Determenes if for example a texture not having alpha still needs to blend when coloring is enabled for example,
         BlendMode BlendModeToUse(const PixelFormatInfo& info);
+        /// @brief Same as above for a coloring other than the context's, e.g. a per sprite tint
+        BlendMode BlendModeToUse(const PixelFormatInfo& info, const Coloring& coloring);
 
         void SetSamplingMethod(SamplingMethod method);
         SamplingMethod GetSamplingMethod();
 
+        /// @brief Smooths the edges of rotated textures and rects by their analytic pixel coverage. Edge pixels are
+        /// blended with their alpha scaled by the coverage, interior pixels are drawn as before. Off by default
+        void EnableEdgeAntialiasing(bool antialiasing);
+        bool IsEdgeAntialiasingEnabled();
+
 
         void ClearTarget(Color color);
         void EnableClipping(bool clipping);
         bool IsClippingEnabled();
-        void SetClipping(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY);
+        void SetClipping(int32_t startX, int32_t startY, int32_t endX, int32_t endY);
 
     	ClippingArea GetClippingArea();
 
@@ -68,16 +86,29 @@ namespace Tergos2D
         BlendContext& GetBlendContext();
         void SetBlendContext(BlendContext context);
 
+        /// @brief Cache used by the BasicTextureRenderer for repeat draws of opaque textures, not owned.
+        /// nullptr (default) disables it
+        void SetConversionCache(ConvertedTextureCache* cache);
+        ConvertedTextureCache* GetConversionCache();
+
+        /// @brief Cache of resampled textures used by the ScaleTextureRenderer and for axis aligned scales in the
+        /// TransformedTextureRenderer, not owned. nullptr (default) disables it
+        void SetScalingCache(ScaledTextureCache* cache);
+        ScaledTextureCache* GetScalingCache();
+
     private:
         Texture *targetTexture = nullptr;
         BlendContext m_BlendContext = BlendContext();
         SamplingMethod samplingMethod = SamplingMethod::NEAREST;
+        bool edgeAntialiasing = false;
 
         Coloring colorOverlay;
         BlendFunc blendFunc = BlendFunctions::BlendRow;
+        ConvertedTextureCache* conversionCache = nullptr;
+        ScaledTextureCache* scalingCache = nullptr;
         // clipping area
         ClippingArea clippingArea;
         bool enableClipping = false;
     };
 }
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,7 +1,43 @@
 #include "RendererBase.h"
+#include "RenderContext2D.h"
+#include <algorithm>
 
 using namespace Tergos2D;
 
 RendererBase::RendererBase(RenderContext2D& context) : context(context){
 }
 
+bool RendererBase::ClipToTarget(int32_t x, int32_t y, uint32_t width, uint32_t height, ClippingArea &clipped)
+{
+    Texture *target = context.GetTargetTexture();
+    if (!target)
+        return false;
+
+    int64_t endX = static_cast<int64_t>(x) + width;
+    int64_t endY = static_cast<int64_t>(y) + height;
+    clipped.startX = std::max(x, static_cast<int32_t>(0));
+    clipped.startY = std::max(y, static_cast<int32_t>(0));
+    endX = std::min(endX, static_cast<int64_t>(target->GetWidth()));
+    endY = std::min(endY, static_cast<int64_t>(target->GetHeight()));
+
+    if (context.IsClippingEnabled())
+    {
+        ClippingArea area = context.GetClippingArea();
+        clipped.startX = std::max(clipped.startX, area.startX);
+        clipped.startY = std::max(clipped.startY, area.startY);
+        endX = std::min(endX, static_cast<int64_t>(area.endX));
+        endY = std::min(endY, static_cast<int64_t>(area.endY));
+    }
+
+    clipped.endX = static_cast<int32_t>(endX);
+    clipped.endY = static_cast<int32_t>(endY);
+    return clipped.startX < clipped.endX && clipped.startY < clipped.endY;
+}
+
+void RendererBase::WriteTransparent(void (*convertFunc)(const uint8_t *, uint8_t *, size_t), uint8_t *dst,
+                                    size_t count, uint32_t targetBytesPerPixel)
+{
+    static const uint8_t zeroPixels[MAXROWLENGTH * MAXBYTESPERPIXEL] = {};
+    for (size_t done = 0; done < count; done += MAXROWLENGTH)
+        convertFunc(zeroPixels, dst + done * targetBytesPerPixel, std::min<size_t>(MAXROWLENGTH, count - done));
+}
@@ -5,8 +5,23 @@
 #define MAXBYTESPERPIXEL 4
 #define MAXROWLENGTH 500
 
+#include <cstdint>
+#include <cmath>
+
 namespace Tergos2D{
     class RenderContext2D;
+    struct ClippingArea;
+
+    /// @brief Converts a floating point screen coordinate to int32_t, saturating
+    /// instead of overflowing when a transform produces values outside the int range.
+    inline int32_t ClampCoordinate(float value)
+    {
+        if (!(value > -2147483520.0f))
+            return INT32_MIN;
+        if (value >= 2147483520.0f)
+            return INT32_MAX;
+        return static_cast<int32_t>(value);
+    }
     
     class RendererBase
     {
@@ -16,9 +31,18 @@ namespace Tergos2D{
 
         
     protected:
+        /// @brief Intersects a rectangle in target space with the clipping area (if enabled) and the target bounds
+        /// @return false if nothing is left to draw
+        bool ClipToTarget(int32_t x, int32_t y, uint32_t width, uint32_t height, ClippingArea &clipped);
+
+        /// @brief Writes count fully transparent (all zero) source pixels through convertFunc, for copies of
+        /// transparent RLE runs that store no pixels
+        static void WriteTransparent(void (*convertFunc)(const uint8_t *, uint8_t *, size_t), uint8_t *dst,
+                                     size_t count, uint32_t targetBytesPerPixel);
+
         RenderContext2D& context;
     };
     
 }
 
-#endif // !RENDERERBASE_H
\ No newline at end of file
+#endif // !RENDERERBASE_H
\ No newline at end of file
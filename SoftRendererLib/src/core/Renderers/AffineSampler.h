@@ -0,0 +1,34 @@
+#ifndef AFFINESAMPLER_H
+#define AFFINESAMPLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+
+namespace Tergos2D
+{
+    /// @brief Nearest neighbour texel fetch along a line of a linear texture, the inner loop of affine texture mapping.
+    /// Positions are 32.32 fixed point and advance by (du, dv) per pixel. The generic implementation gathers eight
+    /// texels per step with AVX2 when the CPU supports it (checked at runtime) and the byte offsets of the row fit
+    /// 31 bits, otherwise it computes four offsets per step with SSE2. The NEON one computes four 32 bit offsets per step.
+    class AffineSampler
+    {
+    public:
+        /// @brief Copies count 4 byte texels sampled at (u, v), (u + du, v + dv), ... to dst.
+        /// Every position has to lie inside the texture, callers clamp the ends of their spans themselves
+        static void SampleRow32(const uint8_t *data, size_t pitch, int64_t u, int64_t v, int64_t du, int64_t dv,
+                                uint8_t *dst, size_t count);
+
+    private:
+        /// @brief Largest byte offset a row of count texels reads from. Positions are linear, so the largest
+        /// column and row are found at one of its ends
+        static size_t LastOffset(size_t pitch, int64_t u, int64_t v, int64_t du, int64_t dv, size_t count)
+        {
+            const int64_t lastU = u + du * static_cast<int64_t>(count - 1);
+            const int64_t lastV = v + dv * static_cast<int64_t>(count - 1);
+            return static_cast<size_t>(std::max(v, lastV) >> 32) * pitch + static_cast<size_t>(std::max(u, lastU) >> 32) * 4;
+        }
+    };
+}
+
+#endif // AFFINESAMPLER_H
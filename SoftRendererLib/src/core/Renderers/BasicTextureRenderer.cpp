@@ -12,47 +12,47 @@ BasicTextureRenderer::BasicTextureRenderer(RenderContext2D &ctx) : RendererBase(
 {
 }
 
- void BasicTextureRenderer::DrawTexture(Texture &texture, int16_t x, int16_t y)
+ void BasicTextureRenderer::DrawTexture(Texture &texture, int32_t x, int32_t y)
 {
-    auto targetTexture = context.GetTargetTexture();
-    if (!targetTexture || !texture.GetData())
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || !texture.GetData() || texture.GetLayout() != TextureLayout::LINEAR)
         return;
 
     // Get target texture information
     PixelFormat targetFormat = targetTexture->GetFormat();
     PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
     uint8_t *targetData = targetTexture->GetData();
-    uint16_t targetWidth = targetTexture->GetWidth();
-    uint16_t targetHeight = targetTexture->GetHeight();
+    uint32_t targetWidth = targetTexture->GetWidth();
+    uint32_t targetHeight = targetTexture->GetHeight();
     size_t targetPitch = targetTexture->GetPitch(); // Row stride for target texture
 
     // Get source texture information
     PixelFormat sourceFormat = texture.GetFormat();
     PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
     uint8_t *sourceData = texture.GetData();
-    uint16_t sourceWidth = texture.GetWidth();
-    uint16_t sourceHeight = texture.GetHeight();
+    uint32_t sourceWidth = texture.GetWidth();
+    uint32_t sourceHeight = texture.GetHeight();
     size_t sourcePitch = texture.GetPitch();
 
     // Set clipping boundaries within the source and target textures
     auto clippingArea = context.GetClippingArea();
-    int16_t clipStartX = context.IsClippingEnabled() ? std::max(x, clippingArea.startX) : x;
-    int16_t clipStartY = context.IsClippingEnabled() ? std::max(y, clippingArea.startY) : y;
-    int16_t clipEndX = context.IsClippingEnabled() ? std::min(static_cast<int>(x + sourceWidth), static_cast<int>(clippingArea.endX)) : x + sourceWidth;
-    int16_t clipEndY = context.IsClippingEnabled() ? std::min(static_cast<int>(y + sourceHeight), static_cast<int>(clippingArea.endY)) : y + sourceHeight;
+    int32_t clipStartX = context.IsClippingEnabled() ? std::max(x, clippingArea.startX) : x;
+    int32_t clipStartY = context.IsClippingEnabled() ? std::max(y, clippingArea.startY) : y;
+    int32_t clipEndX = context.IsClippingEnabled() ? std::min(x + static_cast<int32_t>(sourceWidth), clippingArea.endX) : x + static_cast<int32_t>(sourceWidth);
+    int32_t clipEndY = context.IsClippingEnabled() ? std::min(y + static_cast<int32_t>(sourceHeight), clippingArea.endY) : y + static_cast<int32_t>(sourceHeight);
 
     // Restrict drawing to the target texture’s bounds
-    clipEndX = std::min(clipEndX, (int16_t)targetWidth);
-    clipEndY = std::min(clipEndY, (int16_t)targetHeight);
+    clipEndX = std::min(clipEndX, static_cast<int32_t>(targetWidth));
+    clipEndY = std::min(clipEndY, static_cast<int32_t>(targetHeight));
 
     // Adjust clipping start positions for negative coordinates
     if (x < 0)
     {
-        clipStartX = std::max(clipStartX, static_cast<int16_t>(0));
+        clipStartX = std::max(clipStartX, static_cast<int32_t>(0));
     }
     if (y < 0)
     {
-        clipStartY = std::max(clipStartY, static_cast<int16_t>(0));
+        clipStartY = std::max(clipStartY, static_cast<int32_t>(0));
     }
 
     // Check if there is anything to draw
@@ -63,6 +63,18 @@ BasicTextureRenderer::BasicTextureRenderer(RenderContext2D &ctx) : RendererBase(
     BlendContext bc = context.GetBlendContext();
     bc.mode = context.BlendModeToUse(sourceInfo);
 
+    // repeat draws of opaque textures copy a version already converted (and tinted) for this target
+    ConvertedTextureCache *cache = context.GetConversionCache();
+    Texture *converted = cache ? cache->Get(texture, targetFormat, bc, context.GetColoring(), context.GetBlendFunc()) : nullptr;
+    if (converted)
+    {
+        sourceFormat = targetFormat;
+        sourceInfo = targetInfo;
+        sourceData = converted->GetData();
+        sourcePitch = converted->GetPitch();
+        bc.mode = BlendMode::NOBLEND;
+    }
+
     switch (bc.mode)
     {
     case BlendMode::NOBLEND:
@@ -75,9 +87,9 @@ BasicTextureRenderer::BasicTextureRenderer(RenderContext2D &ctx) : RendererBase(
 
         size_t targetStartOffset = clipStartX * targetInfo.bytesPerPixel;
         size_t sourceStartOffset = (clipStartX - x) * sourceInfo.bytesPerPixel;
-        int16_t dy = clipStartY - y;
+        int32_t dy = clipStartY - y;
 
-        for (uint16_t j = clipStartY; j < clipEndY; ++j)
+        for (int32_t j = clipStartY; j < clipEndY; ++j)
         {
             size_t rowIndex = j - clipStartY;
             uint8_t *targetRow = targetData + j * targetPitch + targetStartOffset;
@@ -95,7 +107,7 @@ BasicTextureRenderer::BasicTextureRenderer(RenderContext2D &ctx) : RendererBase(
         auto blendFunc = context.GetBlendFunc();
         const auto &coloring = context.GetColoring();
 
-        for (uint16_t j = clipStartY; j < clipEndY; ++j)
+        for (int32_t j = clipStartY; j < clipEndY; ++j)
         {
             blendFunc(targetRow, sourceRow, clipEndX - clipStartX, targetInfo, sourceInfo, coloring, false, bc);
             targetRow += targetPitch;
@@ -105,4 +117,349 @@ BasicTextureRenderer::BasicTextureRenderer(RenderContext2D &ctx) : RendererBase(
     }
     break;
     }
-}
\ No newline at end of file
+}
+
+void BasicTextureRenderer::DrawTextures(std::span<const SpriteInstance> instances, bool sortByTexture)
+{
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || instances.empty())
+        return;
+
+    // state shared by the whole batch
+    ClippingArea bounds;
+    if (!ClipToTarget(0, 0, targetTexture->GetWidth(), targetTexture->GetHeight(), bounds))
+        return;
+    PixelFormat targetFormat = targetTexture->GetFormat();
+    const PixelFormatInfo &targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
+    auto blendFunc = context.GetBlendFunc();
+    const Coloring &contextColoring = context.GetColoring();
+    ConvertedTextureCache *cache = context.GetConversionCache();
+    BlendContext bc = context.GetBlendContext();
+
+    batchOrder.resize(instances.size());
+    for (uint32_t i = 0; i < batchOrder.size(); ++i)
+        batchOrder[i] = i;
+    if (sortByTexture)
+    {
+        std::stable_sort(batchOrder.begin(), batchOrder.end(), [&instances](uint32_t a, uint32_t b)
+                         { return std::less<const Texture *>()(instances[a].texture, instances[b].texture); });
+    }
+
+    // state of the current texture, refreshed when the texture or its format changes
+    const Texture *currentTexture = nullptr;
+    PixelFormat sourceFormat = targetFormat;
+    const PixelFormatInfo *sourceInfo = nullptr;
+    PixelConverter::ConvertFunc convertFunc = nullptr;
+
+    for (uint32_t index : batchOrder)
+    {
+        const SpriteInstance &sprite = instances[index];
+        Texture *texture = sprite.texture;
+        if (!texture || !texture->GetData() || texture->GetLayout() != TextureLayout::LINEAR)
+            continue;
+
+        if (texture != currentTexture)
+        {
+            currentTexture = texture;
+            if (!sourceInfo || texture->GetFormat() != sourceFormat)
+            {
+                sourceFormat = texture->GetFormat();
+                sourceInfo = &PixelFormatRegistry::GetInfo(sourceFormat);
+                convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
+            }
+        }
+
+        // source rectangle clamped to the texture
+        uint32_t srcX = std::min(sprite.srcX, texture->GetWidth());
+        uint32_t srcY = std::min(sprite.srcY, texture->GetHeight());
+        uint32_t width = sprite.srcWidth ? std::min(sprite.srcWidth, texture->GetWidth() - srcX) : texture->GetWidth() - srcX;
+        uint32_t height = sprite.srcHeight ? std::min(sprite.srcHeight, texture->GetHeight() - srcY) : texture->GetHeight() - srcY;
+
+        int64_t startX = std::max<int64_t>(sprite.x, bounds.startX);
+        int64_t startY = std::max<int64_t>(sprite.y, bounds.startY);
+        int64_t endX = std::min<int64_t>(static_cast<int64_t>(sprite.x) + width, bounds.endX);
+        int64_t endY = std::min<int64_t>(static_cast<int64_t>(sprite.y) + height, bounds.endY);
+        if (startX >= endX || startY >= endY)
+            continue;
+
+        const Coloring &coloring = sprite.tint.colorEnabled ? sprite.tint : contextColoring;
+        bc.mode = context.BlendModeToUse(*sourceInfo, coloring);
+
+        const uint8_t *sourceData = texture->GetData();
+        size_t sourcePitch = texture->GetPitch();
+        const PixelFormatInfo *rowInfo = sourceInfo;
+        PixelConverter::ConvertFunc rowConvert = convertFunc;
+        Texture *converted = cache ? cache->Get(*texture, targetFormat, bc, coloring, blendFunc) : nullptr;
+        if (converted)
+        {
+            sourceData = converted->GetData();
+            sourcePitch = converted->GetPitch();
+            rowInfo = &targetInfo;
+            rowConvert = PixelConverter::GetConversionFunction(targetFormat, targetFormat);
+            bc.mode = BlendMode::NOBLEND;
+        }
+        if (bc.mode == BlendMode::NOBLEND && !rowConvert)
+            continue;
+
+        // first source column and row read for the visible part, mirrored rectangles are read from the far side
+        size_t length = static_cast<size_t>(endX - startX);
+        size_t rows = static_cast<size_t>(endY - startY);
+        size_t column = sprite.flipHorizontal ? srcX + width - static_cast<size_t>(endX - sprite.x)
+                                              : srcX + static_cast<size_t>(startX - sprite.x);
+        size_t row = sprite.flipVertical ? srcY + height - 1 - static_cast<size_t>(startY - sprite.y)
+                                         : srcY + static_cast<size_t>(startY - sprite.y);
+        ptrdiff_t sourceStep = sprite.flipVertical ? -static_cast<ptrdiff_t>(sourcePitch) : static_cast<ptrdiff_t>(sourcePitch);
+
+        BlitRows(sourceData + row * sourcePitch + column * rowInfo->bytesPerPixel, sourceStep, *rowInfo, rowConvert,
+                 targetData + static_cast<size_t>(startY) * targetPitch + static_cast<size_t>(startX) * targetInfo.bytesPerPixel,
+                 targetPitch, targetInfo, length, rows, sprite.flipHorizontal, bc, coloring);
+    }
+}
+
+void BasicTextureRenderer::DrawTexture(Texture &texture, int32_t x, int32_t y,
+                                       uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight,
+                                       bool flipHorizontal, bool flipVertical)
+{
+    if (srcWidth == 0 || srcHeight == 0)
+        return;
+
+    SpriteInstance sprite;
+    sprite.texture = &texture;
+    sprite.x = x;
+    sprite.y = y;
+    sprite.srcX = srcX;
+    sprite.srcY = srcY;
+    sprite.srcWidth = srcWidth;
+    sprite.srcHeight = srcHeight;
+    sprite.flipHorizontal = flipHorizontal;
+    sprite.flipVertical = flipVertical;
+    DrawTextures(std::span<const SpriteInstance>(&sprite, 1), false);
+}
+
+void BasicTextureRenderer::BlitRows(const uint8_t *sourceRow, ptrdiff_t sourceStep, const PixelFormatInfo &sourceInfo,
+                                    PixelConverter::ConvertFunc convertFunc, uint8_t *targetRow, size_t targetPitch,
+                                    const PixelFormatInfo &targetInfo, size_t length, size_t rows, bool flipHorizontal,
+                                    BlendContext &bc, const Coloring &coloring)
+{
+    auto blendFunc = context.GetBlendFunc();
+    if (!flipHorizontal)
+    {
+        for (size_t j = 0; j < rows; ++j, sourceRow += sourceStep, targetRow += targetPitch)
+        {
+            if (bc.mode == BlendMode::NOBLEND)
+                convertFunc(sourceRow, targetRow, length);
+            else
+                blendFunc(targetRow, sourceRow, length, targetInfo, sourceInfo, coloring, false, bc);
+        }
+        return;
+    }
+
+    PixelConverter::ConvertFunc reverseFunc = PixelConverter::GetReverseFunction(sourceInfo.format);
+    if (!reverseFunc)
+        return;
+
+    // same format copies reverse straight into the target
+    if (bc.mode == BlendMode::NOBLEND && sourceInfo.format == targetInfo.format)
+    {
+        for (size_t j = 0; j < rows; ++j, sourceRow += sourceStep, targetRow += targetPitch)
+            reverseFunc(sourceRow, targetRow, length);
+        return;
+    }
+
+    // otherwise reverse chunks from the right end of the source span into a scratch row
+    uint8_t scratch[MAXROWLENGTH * MAXBYTESPERPIXEL];
+    for (size_t j = 0; j < rows; ++j, sourceRow += sourceStep, targetRow += targetPitch)
+    {
+        for (size_t done = 0; done < length;)
+        {
+            size_t chunk = std::min<size_t>(MAXROWLENGTH, length - done);
+            reverseFunc(sourceRow + (length - done - chunk) * sourceInfo.bytesPerPixel, scratch, chunk);
+            uint8_t *target = targetRow + done * targetInfo.bytesPerPixel;
+            if (bc.mode == BlendMode::NOBLEND)
+                convertFunc(scratch, target, chunk);
+            else
+                blendFunc(target, scratch, chunk, targetInfo, sourceInfo, coloring, false, bc);
+            done += chunk;
+        }
+    }
+}
+
+void BasicTextureRenderer::DrawTexture(const RLETexture &texture, int32_t x, int32_t y)
+{
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || texture.IsEmpty())
+        return;
+
+    PixelFormat targetFormat = targetTexture->GetFormat();
+    PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+
+    ClippingArea clip;
+    if (!ClipToTarget(x, y, texture.GetWidth(), texture.GetHeight(), clip))
+        return;
+
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = context.BlendModeToUse(sourceInfo);
+    const auto &coloring = context.GetColoring();
+    auto blendFunc = context.GetBlendFunc();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
+    bool copyOpaque = convertFunc && BlendFunctions::OpaqueSourceIsCopy(bc, coloring);
+    if (bc.mode == BlendMode::NOBLEND && !convertFunc)
+        return;
+
+    uint32_t sourceStartX = static_cast<uint32_t>(clip.startX - x);
+    uint32_t sourceEndX = static_cast<uint32_t>(clip.endX - x);
+
+    for (int32_t j = clip.startY; j < clip.endY; ++j)
+    {
+        uint8_t *targetRow = targetData + static_cast<size_t>(j) * targetPitch;
+        texture.ForEachRun(static_cast<uint32_t>(j - y), sourceStartX, sourceEndX, [&](const RLERun &run)
+        {
+            uint8_t *dst = targetRow + static_cast<size_t>(x + static_cast<int32_t>(run.start)) * targetInfo.bytesPerPixel;
+            // a copy stores transparent pixels like the Texture path, only blending may skip them
+            if (run.type == RLERunType::TRANSPARENT)
+            {
+                if (bc.mode == BlendMode::NOBLEND)
+                    WriteTransparent(convertFunc, dst, run.length, targetInfo.bytesPerPixel);
+                return;
+            }
+
+            if (bc.mode == BlendMode::NOBLEND || (run.type == RLERunType::OPAQUE && copyOpaque))
+                convertFunc(run.pixels, dst, run.length);
+            else
+                blendFunc(dst, run.pixels, run.length, targetInfo, sourceInfo, coloring, false, bc);
+        });
+    }
+}
+
+void BasicTextureRenderer::DrawTexture(const BlockTexture &texture, int32_t x, int32_t y)
+{
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || texture.IsEmpty())
+        return;
+
+    ClippingArea clip;
+    if (!ClipToTarget(x, y, texture.GetWidth(), texture.GetHeight(), clip))
+        return;
+
+    PixelFormat targetFormat = targetTexture->GetFormat();
+    PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
+
+    // blocks decode to ARGB8888, without punch-through alpha the texture behaves like an opaque format
+    PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(texture.HasAlpha() ? PixelFormat::ARGB8888 : PixelFormat::XRGB8888);
+    PixelFormatInfo decodedInfo = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = context.BlendModeToUse(sourceInfo);
+    const auto &coloring = context.GetColoring();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(PixelFormat::ARGB8888, targetFormat);
+    bool copy = convertFunc && BlendFunctions::OpaqueSourceIsCopy(bc, coloring);
+    if (bc.mode == BlendMode::NOBLEND && !convertFunc)
+        return;
+
+    uint32_t sourceStartX = static_cast<uint32_t>(clip.startX - x);
+    uint32_t sourceEndX = static_cast<uint32_t>(clip.endX - x);
+    uint32_t sourceStartY = static_cast<uint32_t>(clip.startY - y);
+    uint32_t sourceEndY = static_cast<uint32_t>(clip.endY - y);
+    uint32_t firstBlockX = sourceStartX / BLOCK_SIZE;
+    uint32_t lastBlockX = (sourceEndX - 1) / BLOCK_SIZE;
+    uint8_t bytesPerPixel = targetInfo.bytesPerPixel;
+
+    if (copy)
+    {
+        // transparent entries are left untouched unless blending is off entirely
+        bool skipTransparent = bc.mode != BlendMode::NOBLEND;
+        uint8_t palette[4][4];
+        uint8_t targetPalette[4 * MAXBYTESPERPIXEL];
+
+        for (uint32_t blockY = sourceStartY / BLOCK_SIZE; blockY <= (sourceEndY - 1) / BLOCK_SIZE; ++blockY)
+        {
+            uint32_t rowStart = std::max(sourceStartY, blockY * BLOCK_SIZE);
+            uint32_t rowEnd = std::min(sourceEndY, blockY * BLOCK_SIZE + BLOCK_SIZE);
+            const uint8_t *block = texture.GetBlockRow(blockY) + static_cast<size_t>(firstBlockX) * BLOCK_BYTES;
+
+            for (uint32_t blockX = firstBlockX; blockX <= lastBlockX; ++blockX, block += BLOCK_BYTES)
+            {
+                bool hasTransparent = BlockTexture::DecodePalette(block, palette) && skipTransparent;
+                convertFunc(&palette[0][0], targetPalette, 4);
+
+                uint32_t columnStart = std::max(sourceStartX, blockX * BLOCK_SIZE);
+                uint32_t columnEnd = std::min(sourceEndX, blockX * BLOCK_SIZE + BLOCK_SIZE);
+                for (uint32_t row = rowStart; row < rowEnd; ++row)
+                {
+                    uint8_t bits = block[4 + (row & 3)];
+                    uint8_t *dst = targetData + static_cast<size_t>(y + static_cast<int32_t>(row)) * targetPitch +
+                                   static_cast<size_t>(x + static_cast<int32_t>(columnStart)) * bytesPerPixel;
+                    for (uint32_t column = columnStart; column < columnEnd; ++column, dst += bytesPerPixel)
+                    {
+                        uint32_t index = (bits >> (2 * (column & 3))) & 3;
+                        if (hasTransparent && index == 3)
+                            continue;
+                        MemHandler::MemCopy(dst, targetPalette + index * bytesPerPixel, bytesPerPixel);
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // blending or tinting: expand rows of blocks to ARGB8888 in chunks and hand them to the blend kernels
+    const uint32_t chunkBlocks = MAXROWLENGTH / BLOCK_SIZE;
+    alignas(4) uint8_t decoded[chunkBlocks * BLOCK_SIZE * 4];
+    auto blendFunc = context.GetBlendFunc();
+
+    for (uint32_t row = sourceStartY; row < sourceEndY; ++row)
+    {
+        uint8_t *targetRow = targetData + static_cast<size_t>(y + static_cast<int32_t>(row)) * targetPitch;
+        for (uint32_t blockX = firstBlockX; blockX <= lastBlockX; blockX += chunkBlocks)
+        {
+            uint32_t count = std::min(chunkBlocks, lastBlockX + 1 - blockX);
+            texture.DecodeRow(row / BLOCK_SIZE, row & 3, blockX, count, decoded);
+
+            uint32_t columnStart = std::max(sourceStartX, blockX * BLOCK_SIZE);
+            uint32_t columnEnd = std::min(sourceEndX, (blockX + count) * BLOCK_SIZE);
+            const uint8_t *src = decoded + static_cast<size_t>(columnStart - blockX * BLOCK_SIZE) * 4;
+            uint8_t *dst = targetRow + static_cast<size_t>(x + static_cast<int32_t>(columnStart)) * bytesPerPixel;
+            blendFunc(dst, src, columnEnd - columnStart, targetInfo, decodedInfo, coloring, false, bc);
+        }
+    }
+}
+
+void BasicTextureRenderer::DrawTexture(StreamedTexture &texture, int32_t x, int32_t y)
+{
+    if (!texture.IsOpen())
+        return;
+
+    ClippingArea clipped;
+    if (!ClipToTarget(x, y, texture.GetWidth(), texture.GetHeight(), clipped))
+        return;
+
+    // tile range behind the visible rectangle, tiles outside of it are never loaded
+    uint32_t tileSize = texture.GetTileSize();
+    uint32_t firstTileX = static_cast<uint32_t>((static_cast<int64_t>(clipped.startX) - x) / tileSize);
+    uint32_t firstTileY = static_cast<uint32_t>((static_cast<int64_t>(clipped.startY) - y) / tileSize);
+    uint32_t lastTileX = static_cast<uint32_t>((static_cast<int64_t>(clipped.endX) - x - 1) / tileSize);
+    uint32_t lastTileY = static_cast<uint32_t>((static_cast<int64_t>(clipped.endY) - y - 1) / tileSize);
+
+    for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+    {
+        for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+        {
+            Texture *tile = texture.GetTile(tileX, tileY);
+            if (!tile)
+                continue;
+            DrawTexture(*tile,
+                        static_cast<int32_t>(x + static_cast<int64_t>(tileX) * tileSize),
+                        static_cast<int32_t>(y + static_cast<int64_t>(tileY) * tileSize));
+        }
+    }
+}
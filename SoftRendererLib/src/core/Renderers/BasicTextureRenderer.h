@@ -3,20 +3,70 @@
 
 #include "../RendererBase.h"
 #include "../../data/Color.h"
+#include "../../data/BlendMode/BlendMode.h"
+#include "../../data/BlendMode/BlendFunctions.h"
+#include "../../data/PixelFormat/PixelConverter.h"
 #include "../../data/Texture.h"
+#include "../../data/RLETexture.h"
+#include "../../data/BlockTexture.h"
+#include "../../data/StreamedTexture.h"
 #include <functional>
+#include <span>
+#include <vector>
 namespace Tergos2D
 {
     using BlendFunction = std::function<Color(const Color &src, const Color &dst)>;
+
+    /// @brief One sprite of a DrawTextures batch
+    struct SpriteInstance
+    {
+        Texture *texture = nullptr;
+        int32_t x = 0, y = 0;
+        /// source rectangle inside the texture, a width or height of 0 uses the whole texture
+        uint32_t srcX = 0, srcY = 0, srcWidth = 0, srcHeight = 0;
+        /// per sprite coloring, the context coloring is used if it is not enabled
+        Coloring tint;
+        /// mirror the source rectangle
+        bool flipHorizontal = false, flipVertical = false;
+    };
+
     class BasicTextureRenderer : RendererBase
     {
     public:
         BasicTextureRenderer(RenderContext2D &context);
         ~BasicTextureRenderer() = default;
 
-        void DrawTexture(Texture &texture, int16_t x, int16_t y);
+        /// @brief Draws a linear texture, tiled textures are only supported by the TransformedTextureRenderer
+        void DrawTexture(Texture &texture, int32_t x, int32_t y);
+        /// @brief Draws a rectangle of the texture (clamped to the texture) without creating a sub texture,
+        /// optionally mirrored. Mirrored rows go through the reverse row kernels, so flips cost about as much as a copy
+        void DrawTexture(Texture &texture, int32_t x, int32_t y,
+                         uint32_t srcX, uint32_t srcY, uint32_t srcWidth, uint32_t srcHeight,
+                         bool flipHorizontal = false, bool flipVertical = false);
+        /// @brief Decodes while drawing: transparent runs are skipped, opaque runs are converted
+        /// straight into the target and only partially transparent runs are blended
+        void DrawTexture(const RLETexture &texture, int32_t x, int32_t y);
+        /// @brief Expands the visible blocks while drawing. When blending reduces to a copy the block palette
+        /// is converted to the target format once per block and indices are written straight into the target
+        void DrawTexture(const BlockTexture &texture, int32_t x, int32_t y);
+        /// @brief Draws many sprites with target, clipping and blend state resolved once for the batch.
+        /// Format info, blend mode and conversion are only looked up again when the texture or tint changes.
+        /// With sortByTexture instances are drawn grouped by texture (stable, sprites of one texture keep
+        /// their order), which changes the result where sprites of different textures overlap
+        void DrawTextures(std::span<const SpriteInstance> instances, bool sortByTexture = true);
+        /// @brief Loads and draws only the tiles that overlap the visible part of the image
+        void DrawTexture(StreamedTexture &texture, int32_t x, int32_t y);
 
     private:
+        /// @brief Copies or blends an already clipped block of rows. sourceRow is the leftmost pixel of the
+        /// first row to read, sourceStep the byte distance to the next one (negative when flipped vertically).
+        /// With flipHorizontal every row is read right to left
+        void BlitRows(const uint8_t *sourceRow, ptrdiff_t sourceStep, const PixelFormatInfo &sourceInfo,
+                      PixelConverter::ConvertFunc convertFunc, uint8_t *targetRow, size_t targetPitch,
+                      const PixelFormatInfo &targetInfo, size_t length, size_t rows, bool flipHorizontal,
+                      BlendContext &bc, const Coloring &coloring);
+
+        std::vector<uint32_t> batchOrder;
     };
 
 } // namespace Tergos2D
@@ -0,0 +1,75 @@
+#include "EdgeCoverage.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Tergos2D;
+
+EdgeCoverage::EdgeCoverage(const float invMatrix[3][3], float inMinU, float inMaxU, float inMinV, float inMaxV)
+    : uX(invMatrix[0][0]), uY(invMatrix[0][1]), uC(invMatrix[0][2]),
+      vX(invMatrix[1][0]), vY(invMatrix[1][1]), vC(invMatrix[1][2]),
+      minU(inMinU), maxU(inMaxU), minV(inMinV), maxV(inMaxV)
+{
+    stepU = std::max(std::hypot(uX, uY), 1e-9);
+    stepV = std::max(std::hypot(vX, vY), 1e-9);
+}
+
+bool EdgeCoverage::RowSpans(int32_t y, int32_t startX, int32_t endX, int32_t &outerStart, int32_t &innerStart,
+                            int32_t &innerEnd, int32_t &outerEnd) const
+{
+    // columns x with lower <= a * x + b <= upper for both coordinates, the outer span widened and the
+    // inner one narrowed by half a pixel across each edge
+    auto solve = [&](double margin, double &first, double &last)
+    {
+        first = startX;
+        last = endX - 1.0;
+        auto constrain = [&](double a, double b, double lower, double upper)
+        {
+            if (a == 0)
+            {
+                if (b < lower || b > upper)
+                    last = first - 1;
+                return;
+            }
+            double from = (lower - b) / a;
+            double to = (upper - b) / a;
+            if (a < 0)
+                std::swap(from, to);
+            first = std::max(first, std::ceil(from));
+            last = std::min(last, std::floor(to));
+        };
+        constrain(uX, uY * y + uC, minU - margin * stepU, maxU + margin * stepU);
+        constrain(vX, vY * y + vC, minV - margin * stepV, maxV + margin * stepV);
+    };
+
+    double first, last;
+    solve(0.5, first, last);
+    if (first > last)
+        return false;
+    outerStart = static_cast<int32_t>(first);
+    outerEnd = static_cast<int32_t>(last) + 1;
+
+    solve(-0.5, first, last);
+    if (first > last)
+    {
+        // thinner than a pixel, every column is an edge column
+        innerStart = innerEnd = outerEnd;
+        return true;
+    }
+    innerStart = std::clamp(static_cast<int32_t>(first), outerStart, outerEnd);
+    innerEnd = std::clamp(static_cast<int32_t>(last) + 1, innerStart, outerEnd);
+    return true;
+}
+
+void EdgeCoverage::ApplyToAlpha(uint8_t *argb, int32_t x, int32_t y, size_t count) const
+{
+    double u = uX * x + uY * y + uC;
+    double v = vX * x + vY * y + vC;
+    for (size_t i = 0; i < count; ++i, u += uX, v += vX)
+    {
+        double coverage = std::clamp(0.5 + (u - minU) / stepU, 0.0, 1.0) *
+                          std::clamp(0.5 + (maxU - u) / stepU, 0.0, 1.0) *
+                          std::clamp(0.5 + (v - minV) / stepV, 0.0, 1.0) *
+                          std::clamp(0.5 + (maxV - v) / stepV, 0.0, 1.0);
+        argb[i * 4] = static_cast<uint8_t>(argb[i * 4] * coverage + 0.5);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef EDGECOVERAGE_H
+#define EDGECOVERAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Tergos2D
+{
+    /// @brief Analytic coverage of target pixels by a rectangle drawn through an affine matrix, used to smooth the
+    /// edges of rotated textures and rects. Each edge covers clamp(0.5 + d, 0, 1) of a pixel, d being the distance
+    /// of the pixel's sample point to the edge in target pixels, and the four edges multiply. Only the columns near
+    /// an edge need it, RowSpans separates them from the fully covered interior of a row.
+    class EdgeCoverage
+    {
+    public:
+        /// @param invMatrix affine matrix mapping target pixels to source coordinates
+        /// @param minU maxU minV maxV rectangle in source coordinates whose edges are smoothed
+        EdgeCoverage(const float invMatrix[3][3], float minU, float maxU, float minV, float maxV);
+
+        /// @brief Columns of row y within [startX, endX) touched by the rectangle, [outerStart, outerEnd), and the
+        /// fully covered ones inside them, [innerStart, innerEnd). Returns false if the row is not touched
+        bool RowSpans(int32_t y, int32_t startX, int32_t endX, int32_t &outerStart, int32_t &innerStart,
+                      int32_t &innerEnd, int32_t &outerEnd) const;
+
+        /// @brief Multiplies the alpha of count ARGB8888 pixels, the first one at target pixel (x, y), by their coverage
+        void ApplyToAlpha(uint8_t *argb, int32_t x, int32_t y, size_t count) const;
+
+    private:
+        // u = uX * x + uY * y + uC, v likewise
+        double uX, uY, uC;
+        double vX, vY, vC;
+        double minU, maxU, minV, maxV;
+        // source units per target pixel across the u and v edges
+        double stepU, stepV;
+    };
+}
+
+#endif // EDGECOVERAGE_H
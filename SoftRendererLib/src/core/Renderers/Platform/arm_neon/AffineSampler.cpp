@@ -0,0 +1,45 @@
+#include "../../AffineSampler.h"
+#include <arm_neon.h>
+#include <cstring>
+
+using namespace Tergos2D;
+
+void AffineSampler::SampleRow32(const uint8_t *data, size_t pitch, int64_t u, int64_t v, int64_t du, int64_t dv,
+                                uint8_t *dst, size_t count)
+{
+    size_t i = 0;
+    // byte offsets are computed in 32 bit lanes, rows reaching further take the scalar loop
+    if (count >= 4 && LastOffset(pitch, u, v, du, dv, count) <= UINT32_MAX)
+    {
+        // positions advance in 64 bit lanes and are narrowed to four 32 bit byte offsets per step
+        int64x2_t u01 = vcombine_s64(vcreate_s64(static_cast<uint64_t>(u)), vcreate_s64(static_cast<uint64_t>(u + du)));
+        int64x2_t u23 = vcombine_s64(vcreate_s64(static_cast<uint64_t>(u + 2 * du)), vcreate_s64(static_cast<uint64_t>(u + 3 * du)));
+        int64x2_t v01 = vcombine_s64(vcreate_s64(static_cast<uint64_t>(v)), vcreate_s64(static_cast<uint64_t>(v + dv)));
+        int64x2_t v23 = vcombine_s64(vcreate_s64(static_cast<uint64_t>(v + 2 * dv)), vcreate_s64(static_cast<uint64_t>(v + 3 * dv)));
+        const int64x2_t stepU = vdupq_n_s64(du * 4);
+        const int64x2_t stepV = vdupq_n_s64(dv * 4);
+        uint32_t offsets[4];
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t x = vcombine_u32(vmovn_u64(vreinterpretq_u64_s64(vshrq_n_s64(u01, 32))),
+                                        vmovn_u64(vreinterpretq_u64_s64(vshrq_n_s64(u23, 32))));
+            uint32x4_t y = vcombine_u32(vmovn_u64(vreinterpretq_u64_s64(vshrq_n_s64(v01, 32))),
+                                        vmovn_u64(vreinterpretq_u64_s64(vshrq_n_s64(v23, 32))));
+            vst1q_u32(offsets, vmlaq_n_u32(vshlq_n_u32(x, 2), y, static_cast<uint32_t>(pitch)));
+
+            std::memcpy(dst + i * 4, data + offsets[0], 4);
+            std::memcpy(dst + i * 4 + 4, data + offsets[1], 4);
+            std::memcpy(dst + i * 4 + 8, data + offsets[2], 4);
+            std::memcpy(dst + i * 4 + 12, data + offsets[3], 4);
+
+            u01 = vaddq_s64(u01, stepU);
+            u23 = vaddq_s64(u23, stepU);
+            v01 = vaddq_s64(v01, stepV);
+            v23 = vaddq_s64(v23, stepV);
+        }
+        u += du * static_cast<int64_t>(i);
+        v += dv * static_cast<int64_t>(i);
+    }
+    for (; i < count; ++i, u += du, v += dv)
+        std::memcpy(dst + i * 4, data + static_cast<size_t>(v >> 32) * pitch + static_cast<size_t>(u >> 32) * 4, 4);
+}
@@ -0,0 +1,142 @@
+#include "../../RotateBlit.h"
+#include <arm_neon.h>
+#include <cstring>
+
+using namespace Tergos2D;
+
+namespace
+{
+    template <size_t BPP>
+    inline void TransposeTexels(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                                uint32_t startX, uint32_t endX, uint32_t startY, uint32_t endY)
+    {
+        for (uint32_t y = startY; y < endY; ++y)
+        {
+            uint8_t *out = dst + static_cast<ptrdiff_t>(y) * dstPitch;
+            const uint8_t *in = src + y * BPP;
+            for (uint32_t x = startX; x < endX; ++x)
+                std::memcpy(out + x * BPP, in + static_cast<ptrdiff_t>(x) * srcPitch, BPP);
+        }
+    }
+
+    /// @brief Moves whole N x N blocks with block(), the right and bottom remainders texel by texel
+    template <size_t BPP, uint32_t N, typename Block>
+    inline void TransposeBlocks(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                                uint32_t width, uint32_t height, Block block)
+    {
+        const uint32_t blockWidth = width - width % N;
+        const uint32_t blockHeight = height - height % N;
+        for (uint32_t y = 0; y < blockHeight; y += N)
+        {
+            for (uint32_t x = 0; x < blockWidth; x += N)
+                block(src + static_cast<ptrdiff_t>(x) * srcPitch + y * BPP, srcPitch,
+                      dst + static_cast<ptrdiff_t>(y) * dstPitch + x * BPP, dstPitch);
+            TransposeTexels<BPP>(src, srcPitch, dst, dstPitch, blockWidth, width, y, y + N);
+        }
+        TransposeTexels<BPP>(src, srcPitch, dst, dstPitch, 0, width, blockHeight, height);
+    }
+
+    inline void Transpose4x4x32(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        uint32x4_t r0 = vreinterpretq_u32_u8(vld1q_u8(src));
+        uint32x4_t r1 = vreinterpretq_u32_u8(vld1q_u8(src + srcPitch));
+        uint32x4_t r2 = vreinterpretq_u32_u8(vld1q_u8(src + 2 * srcPitch));
+        uint32x4_t r3 = vreinterpretq_u32_u8(vld1q_u8(src + 3 * srcPitch));
+        uint32x4x2_t t01 = vtrnq_u32(r0, r1);
+        uint32x4x2_t t23 = vtrnq_u32(r2, r3);
+        vst1q_u8(dst, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]))));
+        vst1q_u8(dst + dstPitch, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]))));
+        vst1q_u8(dst + 2 * dstPitch, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]))));
+        vst1q_u8(dst + 3 * dstPitch, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]))));
+    }
+
+    inline void Transpose8x8x16(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        uint16x8_t r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = vreinterpretq_u16_u8(vld1q_u8(src + i * srcPitch));
+        // even and odd columns of row pairs, then of row quads, the halves of the last step are the columns
+        uint16x8x2_t t01 = vtrnq_u16(r[0], r[1]);
+        uint16x8x2_t t23 = vtrnq_u16(r[2], r[3]);
+        uint16x8x2_t t45 = vtrnq_u16(r[4], r[5]);
+        uint16x8x2_t t67 = vtrnq_u16(r[6], r[7]);
+        uint32x4x2_t top04 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+        uint32x4x2_t top15 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+        uint32x4x2_t bottom04 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+        uint32x4x2_t bottom15 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+        // top04.val[0] holds columns 0 and 4, val[1] columns 2 and 6, top15 the odd columns
+        const uint32x4x2_t *tops[2] = {&top04, &top15};
+        const uint32x4x2_t *bottoms[2] = {&bottom04, &bottom15};
+        for (int odd = 0; odd < 2; ++odd)
+        {
+            for (int pair = 0; pair < 2; ++pair)
+            {
+                uint32x4_t top = tops[odd]->val[pair];
+                uint32x4_t bottom = bottoms[odd]->val[pair];
+                int column = 2 * pair + odd;
+                vst1q_u8(dst + column * dstPitch, vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(top), vget_low_u32(bottom))));
+                vst1q_u8(dst + (column + 4) * dstPitch, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(top), vget_high_u32(bottom))));
+            }
+        }
+    }
+
+    inline void Transpose8x8x8(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        uint8x8_t r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = vld1_u8(src + i * srcPitch);
+        uint8x8x2_t t01 = vtrn_u8(r[0], r[1]);
+        uint8x8x2_t t23 = vtrn_u8(r[2], r[3]);
+        uint8x8x2_t t45 = vtrn_u8(r[4], r[5]);
+        uint8x8x2_t t67 = vtrn_u8(r[6], r[7]);
+        uint16x4x2_t top04 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+        uint16x4x2_t top15 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+        uint16x4x2_t bottom04 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+        uint16x4x2_t bottom15 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+        const uint16x4x2_t *tops[2] = {&top04, &top15};
+        const uint16x4x2_t *bottoms[2] = {&bottom04, &bottom15};
+        for (int odd = 0; odd < 2; ++odd)
+        {
+            for (int pair = 0; pair < 2; ++pair)
+            {
+                // lane 0 is column 2 * pair + odd, lane 1 the column four further
+                uint32x2x2_t columns = vtrn_u32(vreinterpret_u32_u16(tops[odd]->val[pair]),
+                                                vreinterpret_u32_u16(bottoms[odd]->val[pair]));
+                int column = 2 * pair + odd;
+                vst1_u8(dst + column * dstPitch, vreinterpret_u8_u32(columns.val[0]));
+                vst1_u8(dst + (column + 4) * dstPitch, vreinterpret_u8_u32(columns.val[1]));
+            }
+        }
+    }
+
+    template <size_t BPP>
+    inline void TransposeBlock8(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        for (uint32_t y = 0; y < 8; ++y)
+            for (uint32_t x = 0; x < 8; ++x)
+                std::memcpy(dst + y * dstPitch + x * BPP, src + x * srcPitch + y * BPP, BPP);
+    }
+}
+
+void RotateBlit::Transpose(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                           uint32_t width, uint32_t height, uint32_t bytesPerPixel)
+{
+    switch (bytesPerPixel)
+    {
+    case 4:
+        TransposeBlocks<4, 4>(src, srcPitch, dst, dstPitch, width, height, Transpose4x4x32);
+        break;
+    case 2:
+        TransposeBlocks<2, 8>(src, srcPitch, dst, dstPitch, width, height, Transpose8x8x16);
+        break;
+    case 1:
+        TransposeBlocks<1, 8>(src, srcPitch, dst, dstPitch, width, height, Transpose8x8x8);
+        break;
+    case 3:
+        // no lane width fits three bytes, the blocks still keep both sides in cache
+        TransposeBlocks<3, 8>(src, srcPitch, dst, dstPitch, width, height, TransposeBlock8<3>);
+        break;
+    default:
+        break;
+    }
+}
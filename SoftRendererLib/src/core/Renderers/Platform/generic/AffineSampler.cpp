@@ -0,0 +1,124 @@
+#include "../../AffineSampler.h"
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AFFINESAMPLER_AVX2 1
+#endif
+
+using namespace Tergos2D;
+
+namespace
+{
+#if defined(AFFINESAMPLER_AVX2)
+    /// @brief Eight texels per step through one 32 bit index gather. Positions advance in two sets of 64 bit lanes,
+    /// even and odd pixels, whose high halves are the texel coordinates. Byte offsets must fit a signed 32 bit index
+    __attribute__((target("avx2"))) size_t SampleRow32Avx2(const uint8_t *data, size_t pitch, int64_t u, int64_t v,
+                                                           int64_t du, int64_t dv, uint8_t *dst, size_t count)
+    {
+        __m256i evenU = _mm256_set_epi64x(u + 6 * du, u + 4 * du, u + 2 * du, u);
+        __m256i oddU = _mm256_set_epi64x(u + 7 * du, u + 5 * du, u + 3 * du, u + du);
+        __m256i evenV = _mm256_set_epi64x(v + 6 * dv, v + 4 * dv, v + 2 * dv, v);
+        __m256i oddV = _mm256_set_epi64x(v + 7 * dv, v + 5 * dv, v + 3 * dv, v + dv);
+        const __m256i stepU = _mm256_set1_epi64x(du * 8);
+        const __m256i stepV = _mm256_set1_epi64x(dv * 8);
+        const __m256i pitchLanes = _mm256_set1_epi32(static_cast<int32_t>(pitch));
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // even pixels move down into the low halves, the odd ones keep their high halves
+            __m256i x = _mm256_blend_epi32(_mm256_srli_epi64(evenU, 32), oddU, 0xAA);
+            __m256i y = _mm256_blend_epi32(_mm256_srli_epi64(evenV, 32), oddV, 0xAA);
+            __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(y, pitchLanes), _mm256_slli_epi32(x, 2));
+            __m256i texels = _mm256_i32gather_epi32(reinterpret_cast<const int *>(data), offsets, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), texels);
+            evenU = _mm256_add_epi64(evenU, stepU);
+            oddU = _mm256_add_epi64(oddU, stepU);
+            evenV = _mm256_add_epi64(evenV, stepV);
+            oddV = _mm256_add_epi64(oddV, stepV);
+        }
+        return i;
+    }
+
+    bool HasAvx2()
+    {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+    }
+#endif
+
+#if defined(__SSE2__)
+    /// @brief Byte offset held in the low 64 bit lane, 32 bit targets only address 32 bit offsets
+    inline size_t LowOffset(__m128i offsets)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return static_cast<size_t>(_mm_cvtsi128_si64(offsets));
+#else
+        return static_cast<size_t>(_mm_cvtsi128_si32(offsets));
+#endif
+    }
+
+    inline __m128i LoadTexel(const uint8_t *texel)
+    {
+        int32_t value;
+        std::memcpy(&value, texel, 4);
+        return _mm_cvtsi32_si128(value);
+    }
+
+    /// @brief Four texels per step, byte offsets are computed in 64 bit lanes and the texels loaded one by one
+    size_t SampleRow32Sse2(const uint8_t *data, size_t pitch, int64_t u, int64_t v, int64_t du, int64_t dv,
+                           uint8_t *dst, size_t count)
+    {
+        __m128i lowU = _mm_set_epi64x(u + du, u);
+        __m128i highU = _mm_set_epi64x(u + 3 * du, u + 2 * du);
+        __m128i lowV = _mm_set_epi64x(v + dv, v);
+        __m128i highV = _mm_set_epi64x(v + 3 * dv, v + 2 * dv);
+        const __m128i stepU = _mm_set1_epi64x(du * 4);
+        const __m128i stepV = _mm_set1_epi64x(dv * 4);
+        const __m128i pitchLanes = _mm_set1_epi64x(static_cast<int64_t>(pitch));
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // y * pitch multiplies the low 32 bits of each lane into a full 64 bit product
+            __m128i low = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(lowV, 32), pitchLanes), _mm_slli_epi64(_mm_srli_epi64(lowU, 32), 2));
+            __m128i high = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(highV, 32), pitchLanes), _mm_slli_epi64(_mm_srli_epi64(highU, 32), 2));
+
+            __m128i t0 = LoadTexel(data + LowOffset(low));
+            __m128i t1 = LoadTexel(data + LowOffset(_mm_unpackhi_epi64(low, low)));
+            __m128i t2 = LoadTexel(data + LowOffset(high));
+            __m128i t3 = LoadTexel(data + LowOffset(_mm_unpackhi_epi64(high, high)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),
+                             _mm_unpacklo_epi64(_mm_unpacklo_epi32(t0, t1), _mm_unpacklo_epi32(t2, t3)));
+
+            lowU = _mm_add_epi64(lowU, stepU);
+            highU = _mm_add_epi64(highU, stepU);
+            lowV = _mm_add_epi64(lowV, stepV);
+            highV = _mm_add_epi64(highV, stepV);
+        }
+        return i;
+    }
+#endif
+}
+
+void AffineSampler::SampleRow32(const uint8_t *data, size_t pitch, int64_t u, int64_t v, int64_t du, int64_t dv,
+                                uint8_t *dst, size_t count)
+{
+    size_t i = 0;
+#if defined(AFFINESAMPLER_AVX2)
+    // the gather takes signed 32 bit byte offsets, rows reaching further take the 4 wide path
+    if (count >= 8 && LastOffset(pitch, u, v, du, dv, count) <= INT32_MAX && HasAvx2())
+        i = SampleRow32Avx2(data, pitch, u, v, du, dv, dst, count);
+#endif
+#if defined(__SSE2__)
+    if (i == 0)
+        i = SampleRow32Sse2(data, pitch, u, v, du, dv, dst, count);
+#endif
+    u += du * static_cast<int64_t>(i);
+    v += dv * static_cast<int64_t>(i);
+    for (; i < count; ++i, u += du, v += dv)
+        std::memcpy(dst + i * 4, data + static_cast<size_t>(v >> 32) * pitch + static_cast<size_t>(u >> 32) * 4, 4);
+}
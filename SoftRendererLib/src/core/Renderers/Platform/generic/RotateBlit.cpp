@@ -0,0 +1,151 @@
+#include "../../RotateBlit.h"
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace Tergos2D;
+
+namespace
+{
+    template <size_t BPP>
+    inline void TransposeTexels(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                                uint32_t startX, uint32_t endX, uint32_t startY, uint32_t endY)
+    {
+        for (uint32_t y = startY; y < endY; ++y)
+        {
+            uint8_t *out = dst + static_cast<ptrdiff_t>(y) * dstPitch;
+            const uint8_t *in = src + y * BPP;
+            for (uint32_t x = startX; x < endX; ++x)
+                std::memcpy(out + x * BPP, in + static_cast<ptrdiff_t>(x) * srcPitch, BPP);
+        }
+    }
+
+    /// @brief Moves whole N x N blocks with block(), the right and bottom remainders texel by texel
+    template <size_t BPP, uint32_t N, typename Block>
+    inline void TransposeBlocks(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                                uint32_t width, uint32_t height, Block block)
+    {
+        const uint32_t blockWidth = width - width % N;
+        const uint32_t blockHeight = height - height % N;
+        for (uint32_t y = 0; y < blockHeight; y += N)
+        {
+            for (uint32_t x = 0; x < blockWidth; x += N)
+                block(src + static_cast<ptrdiff_t>(x) * srcPitch + y * BPP, srcPitch,
+                      dst + static_cast<ptrdiff_t>(y) * dstPitch + x * BPP, dstPitch);
+            TransposeTexels<BPP>(src, srcPitch, dst, dstPitch, blockWidth, width, y, y + N);
+        }
+        TransposeTexels<BPP>(src, srcPitch, dst, dstPitch, 0, width, blockHeight, height);
+    }
+
+#if defined(__SSE2__)
+    inline __m128i Load(const uint8_t *src)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    }
+
+    inline void Store(uint8_t *dst, __m128i value)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), value);
+    }
+
+    inline void Transpose4x4x32(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        __m128i r0 = Load(src), r1 = Load(src + srcPitch), r2 = Load(src + 2 * srcPitch), r3 = Load(src + 3 * srcPitch);
+        __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+        __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+        __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+        __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+        Store(dst, _mm_unpacklo_epi64(t0, t1));
+        Store(dst + dstPitch, _mm_unpackhi_epi64(t0, t1));
+        Store(dst + 2 * dstPitch, _mm_unpacklo_epi64(t2, t3));
+        Store(dst + 3 * dstPitch, _mm_unpackhi_epi64(t2, t3));
+    }
+
+    inline void Transpose8x8x16(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        __m128i r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = Load(src + i * srcPitch);
+        // pairs of rows, then quads of rows per 32 bit lane, then all eight rows per column
+        __m128i a = _mm_unpacklo_epi16(r[0], r[1]), b = _mm_unpackhi_epi16(r[0], r[1]);
+        __m128i c = _mm_unpacklo_epi16(r[2], r[3]), d = _mm_unpackhi_epi16(r[2], r[3]);
+        __m128i e = _mm_unpacklo_epi16(r[4], r[5]), f = _mm_unpackhi_epi16(r[4], r[5]);
+        __m128i g = _mm_unpacklo_epi16(r[6], r[7]), h = _mm_unpackhi_epi16(r[6], r[7]);
+        __m128i top01 = _mm_unpacklo_epi32(a, c), top23 = _mm_unpackhi_epi32(a, c);
+        __m128i top45 = _mm_unpacklo_epi32(b, d), top67 = _mm_unpackhi_epi32(b, d);
+        __m128i bottom01 = _mm_unpacklo_epi32(e, g), bottom23 = _mm_unpackhi_epi32(e, g);
+        __m128i bottom45 = _mm_unpacklo_epi32(f, h), bottom67 = _mm_unpackhi_epi32(f, h);
+        Store(dst, _mm_unpacklo_epi64(top01, bottom01));
+        Store(dst + dstPitch, _mm_unpackhi_epi64(top01, bottom01));
+        Store(dst + 2 * dstPitch, _mm_unpacklo_epi64(top23, bottom23));
+        Store(dst + 3 * dstPitch, _mm_unpackhi_epi64(top23, bottom23));
+        Store(dst + 4 * dstPitch, _mm_unpacklo_epi64(top45, bottom45));
+        Store(dst + 5 * dstPitch, _mm_unpackhi_epi64(top45, bottom45));
+        Store(dst + 6 * dstPitch, _mm_unpacklo_epi64(top67, bottom67));
+        Store(dst + 7 * dstPitch, _mm_unpackhi_epi64(top67, bottom67));
+    }
+
+    inline void Transpose8x8x8(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        __m128i r[8];
+        for (int i = 0; i < 8; ++i)
+            r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i * srcPitch));
+        __m128i a = _mm_unpacklo_epi8(r[0], r[1]), b = _mm_unpacklo_epi8(r[2], r[3]);
+        __m128i c = _mm_unpacklo_epi8(r[4], r[5]), d = _mm_unpacklo_epi8(r[6], r[7]);
+        __m128i top0123 = _mm_unpacklo_epi16(a, b), top4567 = _mm_unpackhi_epi16(a, b);
+        __m128i bottom0123 = _mm_unpacklo_epi16(c, d), bottom4567 = _mm_unpackhi_epi16(c, d);
+        // every register holds two finished columns of eight texels
+        __m128i columns[4] = {_mm_unpacklo_epi32(top0123, bottom0123), _mm_unpackhi_epi32(top0123, bottom0123),
+                              _mm_unpacklo_epi32(top4567, bottom4567), _mm_unpackhi_epi32(top4567, bottom4567)};
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 2 * i * dstPitch), columns[i]);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + (2 * i + 1) * dstPitch), _mm_srli_si128(columns[i], 8));
+        }
+    }
+#endif
+
+    template <size_t BPP>
+    inline void TransposeBlock8(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch)
+    {
+        for (uint32_t y = 0; y < 8; ++y)
+            for (uint32_t x = 0; x < 8; ++x)
+                std::memcpy(dst + y * dstPitch + x * BPP, src + x * srcPitch + y * BPP, BPP);
+    }
+}
+
+void RotateBlit::Transpose(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                           uint32_t width, uint32_t height, uint32_t bytesPerPixel)
+{
+    switch (bytesPerPixel)
+    {
+#if defined(__SSE2__)
+    case 4:
+        TransposeBlocks<4, 4>(src, srcPitch, dst, dstPitch, width, height, Transpose4x4x32);
+        break;
+    case 2:
+        TransposeBlocks<2, 8>(src, srcPitch, dst, dstPitch, width, height, Transpose8x8x16);
+        break;
+    case 1:
+        TransposeBlocks<1, 8>(src, srcPitch, dst, dstPitch, width, height, Transpose8x8x8);
+        break;
+#else
+    case 4:
+        TransposeBlocks<4, 8>(src, srcPitch, dst, dstPitch, width, height, TransposeBlock8<4>);
+        break;
+    case 2:
+        TransposeBlocks<2, 8>(src, srcPitch, dst, dstPitch, width, height, TransposeBlock8<2>);
+        break;
+    case 1:
+        TransposeBlocks<1, 8>(src, srcPitch, dst, dstPitch, width, height, TransposeBlock8<1>);
+        break;
+#endif
+    case 3:
+        // no lane width fits three bytes, the blocks still keep both sides in cache
+        TransposeBlocks<3, 8>(src, srcPitch, dst, dstPitch, width, height, TransposeBlock8<3>);
+        break;
+    default:
+        break;
+    }
+}
@@ -1,6 +1,7 @@
 #include "PrimitivesRenderer.h"
 #include <algorithm>
 #include "../util/MemHandler.h"
+#include "EdgeCoverage.h"
 #include "../data/BlendMode/BlendFunctions.h"
 
 #include "../RenderContext2D.h"
@@ -11,9 +12,9 @@ using namespace Tergos2D;
 PrimitivesRenderer::PrimitivesRenderer(RenderContext2D &context) : RendererBase(context)
 {
 }
-void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t length, uint16_t height)
+void PrimitivesRenderer::DrawRect(Color color, int32_t x, int32_t y, uint32_t length, uint32_t height)
 {
-    auto targetTexture = context.GetTargetTexture();
+    auto targetTexture = context.GetDrawTarget();
     if (!targetTexture)
         return;
 
@@ -21,31 +22,27 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
     PixelFormatInfo info = PixelFormatRegistry::GetInfo(format);
 
     uint8_t *textureData = targetTexture->GetData();
-    uint16_t textureWidth = targetTexture->GetWidth();
-    uint16_t textureHeight = targetTexture->GetHeight();
-    uint32_t pitch = targetTexture->GetPitch(); // Get the pitch (bytes per row)
-
-    if (x < 0)
-    {
-        length = length + x;
-        x = 0;
-    }
-    if (y < 0)
-    {
-        height = height + y;
-        y = 0;
-    }
+    uint32_t textureWidth = targetTexture->GetWidth();
+    uint32_t textureHeight = targetTexture->GetHeight();
+    size_t pitch = targetTexture->GetPitch(); // Get the pitch (bytes per row)
 
     auto clippingArea = context.GetClippingArea();
 
-    uint16_t clipStartX = context.IsClippingEnabled() ? std::max(x, clippingArea.startX) : x;
-    uint16_t clipStartY = context.IsClippingEnabled() ? std::max(y, clippingArea.startY) : y;
-    uint16_t clipEndX = context.IsClippingEnabled() ? std::min(static_cast<int>(x + length), static_cast<int>(clippingArea.endX)) : x + length;
-    uint16_t clipEndY = context.IsClippingEnabled() ? std::min(static_cast<int>(y + height), static_cast<int>(clippingArea.endY)) : y + height;
+    int32_t clipStartX = context.IsClippingEnabled() ? std::max(x, clippingArea.startX) : x;
+    int32_t clipStartY = context.IsClippingEnabled() ? std::max(y, clippingArea.startY) : y;
+    int64_t rectEndX = static_cast<int64_t>(x) + length;
+    int64_t rectEndY = static_cast<int64_t>(y) + height;
+    if (context.IsClippingEnabled())
+    {
+        rectEndX = std::min(rectEndX, static_cast<int64_t>(clippingArea.endX));
+        rectEndY = std::min(rectEndY, static_cast<int64_t>(clippingArea.endY));
+    }
 
     // Restrict drawing within the texture bounds
-    clipEndX = std::min(clipEndX, textureWidth);
-    clipEndY = std::min(clipEndY, textureHeight);
+    clipStartX = std::max(clipStartX, static_cast<int32_t>(0));
+    clipStartY = std::max(clipStartY, static_cast<int32_t>(0));
+    int32_t clipEndX = static_cast<int32_t>(std::min(rectEndX, static_cast<int64_t>(textureWidth)));
+    int32_t clipEndY = static_cast<int32_t>(std::min(rectEndY, static_cast<int64_t>(textureHeight)));
 
     // If nothing to draw, return
     if (clipStartX >= clipEndX || clipStartY >= clipEndY)
@@ -58,7 +55,7 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
 
     if (color.GetAlpha() == 255)
         bc.mode = BlendMode::NOBLEND;
-    uint8_t *dest = textureData + (clipStartY * pitch) + (clipStartX * info.bytesPerPixel);
+    uint8_t *dest = textureData + (static_cast<size_t>(clipStartY) * pitch) + (static_cast<size_t>(clipStartX) * info.bytesPerPixel);
 
     uint8_t pixelData[MAXBYTESPERPIXEL];
     uint8_t rowPixelData[MAXROWLENGTH * MAXBYTESPERPIXEL];
@@ -76,13 +73,15 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
         const size_t pixelWidth = clipEndX - clipStartX;
         const size_t bytesPerRow = pixelWidth * info.bytesPerPixel;
 
-        // Fill as much of rowPixelData as needed
-        for (size_t i = 0; i < pixelWidth; ++i)
+        // Fill as much of rowPixelData as needed; wider rows are copied in whole-pixel chunks
+        const size_t bufferPixels = std::min(pixelWidth, static_cast<size_t>(MAXROWLENGTH));
+        const size_t bufferBytes = bufferPixels * info.bytesPerPixel;
+        for (size_t i = 0; i < bufferPixels; ++i)
         {
             MemHandler::MemCopy(rowPixelData + i * info.bytesPerPixel, singlePixelData, info.bytesPerPixel);
         }
 
-        for (uint16_t j = clipStartY; j < clipEndY; ++j)
+        for (int32_t j = clipStartY; j < clipEndY; ++j)
         {
             uint8_t *rowDest = dest + (j - clipStartY) * pitch;
 
@@ -92,7 +91,7 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
 
             while (remaining > 0)
             {
-                size_t copySize = std::min(remaining, sizeof(rowPixelData));
+                size_t copySize = std::min(remaining, bufferBytes);
                 MemHandler::MemCopy(rowDest + offset, rowPixelData, copySize);
                 remaining -= copySize;
                 offset += copySize;
@@ -116,7 +115,7 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
 
         PixelFormatInfo infosrcColor = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
 
-        for (uint16_t j = clipStartY; j < clipEndY; ++j)
+        for (int32_t j = clipStartY; j < clipEndY; ++j)
         {
             uint8_t *rowDest = dest + (j - clipStartY) * pitch;
             size_t remainingPixels = pixelWidth;
@@ -147,20 +146,20 @@ void PrimitivesRenderer::DrawRect(Color color, int16_t x, int16_t y, uint16_t le
 
 }
 
-void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+void PrimitivesRenderer::DrawLine(Color color, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
-    auto targetTexture = context.GetTargetTexture();
+    auto targetTexture = context.GetDrawTarget();
     if (!targetTexture)
         return;
 
     if (x0 == x1)
     {
-        DrawRect(color, x0, y0, 1, y1 - y0);
+        DrawRect(color, x0, std::min(y0, y1), 1, static_cast<uint32_t>(std::abs(y1 - y0)) + 1);
         return;
     }
     if (y0 == y1)
     {
-        DrawRect(color, x0, y0, x1 - x0, 1);
+        DrawRect(color, std::min(x0, x1), y0, static_cast<uint32_t>(std::abs(x1 - x0)) + 1, 1);
         return;
     }
     auto clippingArea = context.GetClippingArea();
@@ -169,7 +168,7 @@ void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x
     if (context.IsClippingEnabled())
     {
         // Cohen-Sutherland clipping algorithm
-        auto clipCode = [](int16_t x, int16_t y, const ClippingArea &clip)
+        auto clipCode = [](int32_t x, int32_t y, const ClippingArea &clip)
         {
             int code = 0;
             if (x < clip.startX)
@@ -201,7 +200,7 @@ void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x
             else
             {
                 int codeOut = code0 ? code0 : code1;
-                int16_t x, y;
+                int32_t x, y;
 
                 if (codeOut & 8)
                 {
@@ -249,15 +248,15 @@ void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x
     PixelFormatInfo info = PixelFormatRegistry::GetInfo(format);
 
     uint8_t *textureData = targetTexture->GetData();
-    uint16_t textureWidth = targetTexture->GetWidth();
-    uint16_t textureHeight = targetTexture->GetHeight();
-    uint32_t pitch = targetTexture->GetPitch();
+    int32_t textureWidth = static_cast<int32_t>(targetTexture->GetWidth());
+    int32_t textureHeight = static_cast<int32_t>(targetTexture->GetHeight());
+    size_t pitch = targetTexture->GetPitch();
 
-    int16_t dx = std::abs(x1 - x0);
-    int16_t dy = std::abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
+    int32_t dx = std::abs(x1 - x0);
+    int32_t dy = std::abs(y1 - y0);
+    int32_t sx = (x0 < x1) ? 1 : -1;
+    int32_t sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx - dy;
 
     BlendContext bc = context.GetBlendContext();
 
@@ -284,7 +283,7 @@ void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x
         if (x0 == x1 && y0 == y1)
             break;
 
-        int16_t e2 = 2 * err;
+        int32_t e2 = 2 * err;
         if (e2 > -dy)
         {
             err -= dy;
@@ -299,9 +298,9 @@ void PrimitivesRenderer::DrawLine(Color color, int16_t x0, int16_t y0, int16_t x
 }
 
 
-void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint16_t height, const float transformationMatrix[3][3])
+void PrimitivesRenderer::DrawTransformedRect(Color color, uint32_t length, uint32_t height, const float transformationMatrix[3][3])
 {
-    auto targetTexture = context.GetTargetTexture();
+    auto targetTexture = context.GetDrawTarget();
     if (!targetTexture)
         return;
 
@@ -323,7 +322,8 @@ void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint1
     float angleInRadians = std::atan2(rotateSin, rotateCos);
     float angleInDegrees = angleInRadians * (180.0f / 3.14159265358979323846f);
 
-    if((int)std::round(angleInDegrees) % 90 == 0)
+    // the shortcut would snap slightly rotated rects to hard axis aligned edges
+    if(!context.IsEdgeAntialiasingEnabled() && (int)std::round(angleInDegrees) % 90 == 0)
     {
         // Need to handle different angles correctly
         int angle = ((int)std::round(angleInDegrees) % 360 + 360) % 360; // normalize to 0-359
@@ -355,9 +355,9 @@ void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint1
     PixelFormatInfo info = PixelFormatRegistry::GetInfo(format);
 
     uint8_t *textureData = targetTexture->GetData();
-    uint16_t textureWidth = targetTexture->GetWidth();
-    uint16_t textureHeight = targetTexture->GetHeight();
-    uint32_t pitch = targetTexture->GetPitch();
+    uint32_t textureWidth = targetTexture->GetWidth();
+    uint32_t textureHeight = targetTexture->GetHeight();
+    size_t pitch = targetTexture->GetPitch();
 
 
     // Calculate the bounding box of the transformed rectangle
@@ -384,19 +384,28 @@ void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint1
         if (y > maxY) maxY = y;
     }
 
+    // smoothed edges reach up to a pixel past the corners
+    if (context.IsEdgeAntialiasingEnabled())
+    {
+        minX -= 1.0f;
+        minY -= 1.0f;
+        maxX += 1.0f;
+        maxY += 1.0f;
+    }
+
     // Clamp the bounding box to the target texture's dimensions
-    int16_t startX = std::max(static_cast<int16_t>(std::floor(minX)), static_cast<int16_t>(0));
-    int16_t startY = std::max(static_cast<int16_t>(std::floor(minY)), static_cast<int16_t>(0));
-    int16_t endX = std::min(static_cast<int16_t>(std::ceil(maxX)), static_cast<int16_t>(textureWidth));
-    int16_t endY = std::min(static_cast<int16_t>(std::ceil(maxY)), static_cast<int16_t>(textureHeight));
+    int32_t startX = std::max(ClampCoordinate(std::floor(minX)), static_cast<int32_t>(0));
+    int32_t startY = std::max(ClampCoordinate(std::floor(minY)), static_cast<int32_t>(0));
+    int32_t endX = std::min(ClampCoordinate(std::ceil(maxX)), static_cast<int32_t>(textureWidth));
+    int32_t endY = std::min(ClampCoordinate(std::ceil(maxY)), static_cast<int32_t>(textureHeight));
 
     if (context.IsClippingEnabled())
     {
         auto clippingArea = context.GetClippingArea();
-        startX = std::max(startX, static_cast<int16_t>(clippingArea.startX));
-        startY = std::max(startY, static_cast<int16_t>(clippingArea.startY));
-        endX = std::min(endX, static_cast<int16_t>(clippingArea.endX));
-        endY = std::min(endY, static_cast<int16_t>(clippingArea.endY));
+        startX = std::max(startX, static_cast<int32_t>(clippingArea.startX));
+        startY = std::max(startY, static_cast<int32_t>(clippingArea.startY));
+        endX = std::min(endX, static_cast<int32_t>(clippingArea.endX));
+        endY = std::min(endY, static_cast<int32_t>(clippingArea.endY));
     }
 
     // Define the inverse transformation matrix
@@ -427,11 +436,65 @@ void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint1
 
     uint8_t pixelData[MAXBYTESPERPIXEL];
     color.ConvertTo(format, pixelData);
+    const PixelFormatInfo &colorInfo = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
+
+    if (context.IsEdgeAntialiasingEnabled())
+    {
+        // interior spans are filled like DrawRect, edge pixels blend the color with their coverage as alpha
+        const EdgeCoverage edges(invMatrix, 0.0f, static_cast<float>(length), 0.0f, static_cast<float>(height));
+        BlendContext edgeContext = bc;
+        edgeContext.mode = BlendMode::BLEND;
+        const Coloring edgeColoring = bc.mode == BlendMode::NOBLEND ? Coloring() : context.GetColoring();
+        uint8_t rowPixelData[MAX_BUFFER_SIZE * 4];
+        uint8_t edgePixelData[MAX_BUFFER_SIZE * 4];
+        for (size_t i = 0; i < MAX_BUFFER_SIZE; ++i)
+            MemHandler::MemCopy(rowPixelData + i * 4, color.data, 4);
+
+        auto fillSpan = [&](int32_t y, int32_t from, int32_t to)
+        {
+            uint8_t *dest = textureData + y * pitch + from * info.bytesPerPixel;
+            if (bc.mode == BlendMode::NOBLEND)
+            {
+                for (int32_t x = from; x < to; ++x, dest += info.bytesPerPixel)
+                    MemHandler::MemCopy(dest, pixelData, info.bytesPerPixel);
+                return;
+            }
+            for (int32_t x = from; x < to; x += MAX_BUFFER_SIZE)
+            {
+                size_t count = std::min<size_t>(MAX_BUFFER_SIZE, to - x);
+                context.GetBlendFunc()(dest, rowPixelData, count, info, colorInfo, context.GetColoring(), true, bc);
+                dest += count * info.bytesPerPixel;
+            }
+        };
+        auto blendEdge = [&](int32_t y, int32_t from, int32_t to)
+        {
+            uint8_t *dest = textureData + y * pitch + from * info.bytesPerPixel;
+            for (int32_t x = from; x < to; x += MAX_BUFFER_SIZE)
+            {
+                size_t count = std::min<size_t>(MAX_BUFFER_SIZE, to - x);
+                MemHandler::MemCopy(edgePixelData, rowPixelData, count * 4);
+                edges.ApplyToAlpha(edgePixelData, x, y, count);
+                context.GetBlendFunc()(dest, edgePixelData, count, info, colorInfo, edgeColoring, false, edgeContext);
+                dest += count * info.bytesPerPixel;
+            }
+        };
+
+        for (int32_t y = startY; y < endY; ++y)
+        {
+            int32_t outerStart, innerStart, innerEnd, outerEnd;
+            if (!edges.RowSpans(y, startX, endX, outerStart, innerStart, innerEnd, outerEnd))
+                continue;
+            blendEdge(y, outerStart, innerStart);
+            fillSpan(y, innerStart, innerEnd);
+            blendEdge(y, innerEnd, outerEnd);
+        }
+        return;
+    }
 
     // Iterate over the bounding box in the target texture
-    for (int16_t y = startY; y < endY; ++y)
+    for (int32_t y = startY; y < endY; ++y)
     {
-        for (int16_t x = startX; x < endX; ++x)
+        for (int32_t x = startX; x < endX; ++x)
         {
             // Apply the inverse transformation to find the corresponding source pixel
             float srcX = invMatrix[0][0] * x + invMatrix[0][1] * y + invMatrix[0][2];
@@ -448,7 +511,7 @@ void PrimitivesRenderer::DrawTransformedRect(Color color, uint16_t length, uint1
                     MemHandler::MemCopy(dest, pixelData, info.bytesPerPixel);
                     break;
                 default:
-                    context.GetBlendFunc()(dest, pixelData, 1, info, PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888), context.GetColoring(), true, bc);
+                    context.GetBlendFunc()(dest, color.data, 1, info, colorInfo, context.GetColoring(), true, bc);
                     break;
                 }
             }
@@ -13,11 +13,11 @@ namespace Tergos2D
         PrimitivesRenderer(RenderContext2D &context);
         ~PrimitivesRenderer() = default;
 
-        void DrawLine(Color color, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
-        void DrawRect(Color color, int16_t x, int16_t y, uint16_t length, uint16_t height);
+        void DrawLine(Color color, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+        void DrawRect(Color color, int32_t x, int32_t y, uint32_t length, uint32_t height);
 
 
-        void DrawTransformedRect(Color color, uint16_t length, uint16_t height, const float transformationMatrix[3][3]);
+        void DrawTransformedRect(Color color, uint32_t length, uint32_t height, const float transformationMatrix[3][3]);
 
         private:
     };
@@ -0,0 +1,22 @@
+#ifndef ROTATEBLIT_H
+#define ROTATEBLIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Tergos2D
+{
+    /// @brief Transposes blocks of texels for 90 and 270 degree blits. Texels are moved in square blocks held in
+    /// registers (4x4 for 4 byte, 8x8 for 2 and 1 byte texels), so source columns are read a cache line at a time
+    /// instead of one texel per row. The generic implementation uses SSE2 when the compiler targets it.
+    class RotateBlit
+    {
+    public:
+        /// @brief Writes texel y of source row x to texel x of target row y for a width x height target area.
+        /// Pitches may be negative to walk rows bottom up, which turns the transpose into a 90 or 270 degree rotation
+        static void Transpose(const uint8_t *src, ptrdiff_t srcPitch, uint8_t *dst, ptrdiff_t dstPitch,
+                              uint32_t width, uint32_t height, uint32_t bytesPerPixel);
+    };
+}
+
+#endif // ROTATEBLIT_H
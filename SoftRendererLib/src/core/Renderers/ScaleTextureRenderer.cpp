@@ -1,5 +1,6 @@
 #include "ScaleTextureRenderer.h"
 #include <algorithm>
+#include <cstring>
 #include "../../util/MemHandler.h"
 #include "../../data/BlendMode/BlendFunctions.h"
 #include "../../data/PixelFormat/PixelConverter.h"
@@ -12,11 +13,11 @@ ScaleTextureRenderer::ScaleTextureRenderer(RenderContext2D &context) : RendererB
 {
 }
 
-void ScaleTextureRenderer::DrawTexture(Texture &texture, int16_t x, int16_t y,
+void ScaleTextureRenderer::DrawTexture(Texture &texture, int32_t x, int32_t y,
                                        float scaleX, float scaleY)
 {
-    auto targetTexture = context.GetTargetTexture();
-    if (!targetTexture || !texture.GetData() || scaleX <= 0 || scaleY <= 0)
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || !texture.GetData() || texture.GetLayout() != TextureLayout::LINEAR || scaleX <= 0 || scaleY <= 0)
         return;
 
     if (scaleX == 1 && scaleY == 1)
@@ -24,140 +25,563 @@ void ScaleTextureRenderer::DrawTexture(Texture &texture, int16_t x, int16_t y,
         context.basicTextureRenderer.DrawTexture(texture, x, y);
         return;
     }
-    // Get format information
-    PixelFormat targetFormat = targetTexture->GetFormat();
-    PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
-    PixelFormat sourceFormat = texture.GetFormat();
-    PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
 
-    uint8_t *targetData = targetTexture->GetData();
-    uint16_t targetWidth = targetTexture->GetWidth();
-    uint16_t targetHeight = targetTexture->GetHeight();
-    size_t targetPitch = targetTexture->GetPitch();
+    // static scales are resampled once into the cache and drawn like any other texture from then on
+    ScaledTextureCache *cache = context.GetScalingCache();
+    if (cache)
+    {
+        uint32_t dstWidth = static_cast<uint32_t>(texture.GetWidth() * scaleX);
+        uint32_t dstHeight = static_cast<uint32_t>(texture.GetHeight() * scaleY);
+        SamplingMethod method = context.GetSamplingMethod();
+        // filtered results are ARGB8888, sources without alpha keep their copy opaque so it blends the same way
+        PixelFormat format = texture.GetFormat();
+        if (method != SamplingMethod::NEAREST)
+            format = PixelFormatRegistry::GetInfo(format).hasAlpha ? PixelFormat::ARGB8888 : PixelFormat::RGB24;
 
-    // Get source texture information
-    uint8_t *sourceData = texture.GetData();
-    uint16_t sourceWidth = texture.GetWidth();
-    uint16_t sourceHeight = texture.GetHeight();
-    size_t sourcePitch = texture.GetPitch();
+        bool filled = false;
+        Texture *scaled = cache->Acquire(texture, dstWidth, dstHeight, static_cast<uint32_t>(method), format, filled);
+        if (scaled)
+        {
+            if (!filled)
+                Resample(texture, *scaled, 0, 0, scaleX, scaleY, true);
+            context.basicTextureRenderer.DrawTexture(*scaled, x, y);
+            return;
+        }
+    }
 
-    // Calculate scaled dimensions
-    uint16_t dstWidth = static_cast<uint16_t>(sourceWidth * scaleX);
-    uint16_t dstHeight = static_cast<uint16_t>(sourceHeight * scaleY);
-
-    // Set clipping boundaries based on SCALED size
-    auto clippingArea = context.GetClippingArea();
-    int16_t clipStartX = context.IsClippingEnabled() ? std::max(x, clippingArea.startX) : x;
-    int16_t clipStartY = context.IsClippingEnabled() ? std::max(y, clippingArea.startY) : y;
-    int16_t clipEndX = context.IsClippingEnabled()
-                           ? std::min(static_cast<int>(x + dstWidth), static_cast<int>(clippingArea.endX))
-                           : x + dstWidth;
-    int16_t clipEndY = context.IsClippingEnabled()
-                           ? std::min(static_cast<int>(y + dstHeight), static_cast<int>(clippingArea.endY))
-                           : y + dstHeight;
-
-    // Clamp to target texture bounds
-    clipEndX = std::min(clipEndX, (int16_t)targetWidth);
-    clipEndY = std::min(clipEndY, (int16_t)targetHeight);
-
-    if (clipStartX >= clipEndX || clipStartY >= clipEndY)
+    Resample(texture, *targetTexture, x, y, scaleX, scaleY, false);
+}
+
+void ScaleTextureRenderer::Resample(Texture &texture, Texture &target, int32_t x, int32_t y,
+                                    float scaleX, float scaleY, bool copy)
+{
+    // minified draws sample the closest mip level instead of skipping over level 0
+    uint32_t mipLevel = texture.SelectMip(std::sqrt(scaleX * scaleY));
+    if (mipLevel > 0)
+    {
+        Texture &mip = texture.GetMip(mipLevel);
+        // keep the drawn size identical to the one level 0 would produce
+        uint32_t dstWidth = static_cast<uint32_t>(texture.GetWidth() * scaleX);
+        uint32_t dstHeight = static_cast<uint32_t>(texture.GetHeight() * scaleY);
+        if (dstWidth == mip.GetWidth() && dstHeight == mip.GetHeight() && !copy)
+            context.basicTextureRenderer.DrawTexture(mip, x, y);
+        else
+            Resample(mip, target, x, y, (dstWidth + 0.5f) / mip.GetWidth(), (dstHeight + 0.5f) / mip.GetHeight(), copy);
         return;
+    }
+    uint32_t dstWidth = static_cast<uint32_t>(texture.GetWidth() * scaleX);
+    uint32_t dstHeight = static_cast<uint32_t>(texture.GetHeight() * scaleY);
+    if (dstWidth == 0 || dstHeight == 0)
+        return;
+
+    // copies fill the whole target, draws are clipped and blended as configured on the context
+    ClippingArea clip;
+    BlendMode mode = BlendMode::NOBLEND;
+    if (copy)
+    {
+        clip = {0, 0, static_cast<int32_t>(std::min(dstWidth, target.GetWidth())), static_cast<int32_t>(std::min(dstHeight, target.GetHeight()))};
+    }
+    else
+    {
+        if (!ClipToTarget(x, y, dstWidth, dstHeight, clip))
+            return;
+        mode = context.BlendModeToUse(PixelFormatRegistry::GetInfo(texture.GetFormat()));
+    }
+
+    // integer upscales turn every source pixel into a block of identical pixels
+    bool integerFactor = scaleX == std::floor(scaleX) && scaleY == std::floor(scaleY);
+    if (context.GetSamplingMethod() == SamplingMethod::NEAREST && integerFactor)
+        DrawReplicated(texture, target, x, y, static_cast<uint32_t>(scaleX), static_cast<uint32_t>(scaleY), clip, mode);
+    else if (context.GetSamplingMethod() == SamplingMethod::NEAREST)
+        DrawNearest(texture, target, x, y, dstWidth, dstHeight, clip, mode);
+    else
+        DrawFiltered(texture, target, x, y, dstWidth, dstHeight, clip, mode, context.GetSamplingMethod() == SamplingMethod::AREA);
+}
+
+void ScaleTextureRenderer::DrawNearest(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t dstWidth, uint32_t dstHeight,
+                                       const ClippingArea &clip, BlendMode mode)
+{
+    PixelFormat targetFormat = target.GetFormat();
+    const PixelFormatInfo &targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = target.GetData();
+    size_t targetPitch = target.GetPitch();
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    const PixelFormatInfo &sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    const uint8_t *sourceData = texture.GetData();
+    uint32_t sourceWidth = texture.GetWidth();
+    uint32_t sourceHeight = texture.GetHeight();
+    size_t sourcePitch = texture.GetPitch();
+    size_t bpp = sourceInfo.bytesPerPixel;
 
-    // Prepare blending mode
     BlendContext bc = context.GetBlendContext();
-    bc.mode = context.BlendModeToUse(sourceInfo);
+    bc.mode = mode;
+    const auto &coloring = context.GetColoring();
+    auto blendFunc = context.GetBlendFunc();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
+    if (bc.mode == BlendMode::NOBLEND && !convertFunc)
+        return;
+
+    // 16.16 source steps per target pixel, samples are rounded to the closest source pixel
+    const NearestAxis columns(sourceWidth, dstWidth, 0);
+    const NearestAxis rows(sourceHeight, dstHeight, 0);
+
+    const size_t length = static_cast<size_t>(clip.endX - clip.startX);
+    columnOffsets.resize(length);
+    for (size_t i = 0; i < length; ++i)
+        columnOffsets[i] = static_cast<uint32_t>(columns(static_cast<uint32_t>(clip.startX - x + i)) * bpp);
+
+    // same format copies gather straight into the target row
+    const bool direct = bc.mode == BlendMode::NOBLEND && sourceFormat == targetFormat;
+    if (!direct)
+        rowBuffer.resize(length * bpp);
 
-    uint8_t dstBuffer[MAXBYTESPERPIXEL];
+    uint8_t *targetRow = targetData + static_cast<size_t>(clip.startY) * targetPitch + static_cast<size_t>(clip.startX) * targetInfo.bytesPerPixel;
+    uint8_t *previousRow = nullptr;
+    uint32_t previousSy = UINT32_MAX;
 
-    for (int16_t dy = clipStartY; dy < clipEndY; dy++)
+    for (int32_t dy = clip.startY; dy < clip.endY; ++dy, targetRow += targetPitch)
     {
-        if (dy < 0)
+        uint32_t sy = rows(static_cast<uint32_t>(dy - y));
+        if (sy == previousSy && bc.mode == BlendMode::NOBLEND)
+        {
+            // upscaled rows repeat, the finished target row is copied instead of sampled again
+            MemHandler::MemCopy(targetRow, previousRow, length * targetInfo.bytesPerPixel);
             continue;
-        for (int16_t dx = clipStartX; dx < clipEndX; dx++)
+        }
+
+        uint8_t *gathered = direct ? targetRow : rowBuffer.data();
+        if (sy != previousSy)
         {
-            if (dx < 0)
-                continue;
-            // Calculate normalized texture coordinates with inverse scaling
-            float tx = (dx - x) * (static_cast<float>(sourceWidth) / dstWidth);
-            float ty = (dy - y) * (static_cast<float>(sourceHeight) / dstHeight);
+            const uint8_t *sourceRow = sourceData + static_cast<size_t>(sy) * sourcePitch;
+            switch (bpp)
+            {
+            case 1:
+                for (size_t i = 0; i < length; ++i)
+                    gathered[i] = sourceRow[columnOffsets[i]];
+                break;
+            case 2:
+                for (size_t i = 0; i < length; ++i)
+                    std::memcpy(gathered + i * 2, sourceRow + columnOffsets[i], 2);
+                break;
+            case 3:
+                for (size_t i = 0; i < length; ++i)
+                {
+                    const uint8_t *pixel = sourceRow + columnOffsets[i];
+                    gathered[i * 3] = pixel[0];
+                    gathered[i * 3 + 1] = pixel[1];
+                    gathered[i * 3 + 2] = pixel[2];
+                }
+                break;
+            default:
+                for (size_t i = 0; i < length; ++i)
+                    std::memcpy(gathered + i * 4, sourceRow + columnOffsets[i], 4);
+                break;
+            }
+            previousSy = sy;
+        }
+        previousRow = targetRow;
 
-            // Clamp coordinates to texture size
-            tx = std::max(0.0f, std::min(tx, static_cast<float>(sourceWidth - 1)));
-            ty = std::max(0.0f, std::min(ty, static_cast<float>(sourceHeight - 1)));
+        if (direct)
+            continue;
+        if (bc.mode == BlendMode::NOBLEND)
+        {
+            convertFunc(gathered, targetRow, length);
+            continue;
+        }
+        for (size_t done = 0; done < length; done += MAXROWLENGTH)
+        {
+            size_t chunk = std::min<size_t>(MAXROWLENGTH, length - done);
+            blendFunc(targetRow + done * targetInfo.bytesPerPixel, gathered + done * bpp, chunk,
+                      targetInfo, sourceInfo, coloring, false, bc);
+        }
+    }
+}
 
-            // Sample texture
-            switch (context.GetSamplingMethod())
-            {
-            case SamplingMethod::NEAREST:
+void ScaleTextureRenderer::DrawReplicated(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t factorX, uint32_t factorY,
+                                          const ClippingArea &clip, BlendMode mode)
+{
+    PixelFormat targetFormat = target.GetFormat();
+    const PixelFormatInfo &targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = target.GetData();
+    size_t targetPitch = target.GetPitch();
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    const PixelFormatInfo &sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    const uint8_t *sourceData = texture.GetData();
+    size_t sourcePitch = texture.GetPitch();
+    size_t bpp = sourceInfo.bytesPerPixel;
+
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = mode;
+    const auto &coloring = context.GetColoring();
+    auto blendFunc = context.GetBlendFunc();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
+    if (bc.mode == BlendMode::NOBLEND && !convertFunc)
+        return;
+
+    // whole source columns touching the clipped span are widened, skip is the part of the first block left of it
+    const NearestAxis columnAxis(texture.GetWidth(), texture.GetWidth() * factorX, factorX);
+    const NearestAxis rows(texture.GetHeight(), texture.GetHeight() * factorY, factorY);
+    const size_t length = static_cast<size_t>(clip.endX - clip.startX);
+    const uint32_t firstColumn = columnAxis(static_cast<uint32_t>(clip.startX - x));
+    const uint32_t lastColumn = columnAxis(static_cast<uint32_t>(clip.endX - 1 - x));
+    const size_t skip = static_cast<size_t>(clip.startX - x) % factorX;
+    const size_t columns = lastColumn - firstColumn + 1;
+    rowBuffer.resize(columns * factorX * bpp);
+
+    uint8_t *targetRow = targetData + static_cast<size_t>(clip.startY) * targetPitch + static_cast<size_t>(clip.startX) * targetInfo.bytesPerPixel;
+    uint8_t *previousRow = nullptr;
+    uint32_t previousSy = UINT32_MAX;
+    for (int32_t dy = clip.startY; dy < clip.endY; ++dy, targetRow += targetPitch)
+    {
+        uint32_t sy = rows(static_cast<uint32_t>(dy - y));
+        if (sy == previousSy && bc.mode == BlendMode::NOBLEND)
+        {
+            // the remaining rows of a block are copies of the first one
+            MemHandler::MemCopy(targetRow, previousRow, length * targetInfo.bytesPerPixel);
+            continue;
+        }
+        if (sy != previousSy)
+        {
+            const uint8_t *sourceRow = sourceData + static_cast<size_t>(sy) * sourcePitch + static_cast<size_t>(firstColumn) * bpp;
+            switch (bpp)
             {
-                // Nearest neighbor sampling
-                uint16_t sx = static_cast<uint16_t>(tx + 0.5f);
-                uint16_t sy = static_cast<uint16_t>(ty + 0.5f);
-                const uint8_t *srcPixel = sourceData +
-                                          sy * sourcePitch +
-                                          sx * sourceInfo.bytesPerPixel;
-
-                PixelConverter::Convert(
-                    sourceFormat,
-                    targetFormat,
-                    srcPixel,
-                    dstBuffer,
-                    1);
+            case 1:
+                WidenRow<uint8_t>(sourceRow, rowBuffer.data(), columns, factorX);
+                break;
+            case 2:
+                WidenRow<uint16_t>(sourceRow, rowBuffer.data(), columns, factorX);
+                break;
+            case 3:
+                for (size_t i = 0; i < columns; ++i)
+                    for (uint32_t k = 0; k < factorX; ++k)
+                        std::memcpy(rowBuffer.data() + (i * factorX + k) * 3, sourceRow + i * 3, 3);
+                break;
+            default:
+                WidenRow<uint32_t>(sourceRow, rowBuffer.data(), columns, factorX);
                 break;
             }
+            previousSy = sy;
+        }
+        previousRow = targetRow;
 
-            case SamplingMethod::LINEAR:
+        const uint8_t *widened = rowBuffer.data() + skip * bpp;
+        if (bc.mode == BlendMode::NOBLEND)
+        {
+            convertFunc(widened, targetRow, length);
+            continue;
+        }
+        for (size_t done = 0; done < length; done += MAXROWLENGTH)
+        {
+            size_t chunk = std::min<size_t>(MAXROWLENGTH, length - done);
+            blendFunc(targetRow + done * targetInfo.bytesPerPixel, widened + done * bpp, chunk,
+                      targetInfo, sourceInfo, coloring, false, bc);
+        }
+    }
+}
+
+void ScaleTextureRenderer::DrawFiltered(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t dstWidth, uint32_t dstHeight,
+                                        const ClippingArea &clip, BlendMode mode, bool area)
+{
+    PixelFormat targetFormat = target.GetFormat();
+    const PixelFormatInfo &targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    const PixelFormatInfo &filteredInfo = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
+    uint8_t *targetData = target.GetData();
+    size_t targetPitch = target.GetPitch();
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    const PixelFormatInfo &sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    const uint8_t *sourceData = texture.GetData();
+    const uint64_t sourceWidth = texture.GetWidth();
+    const uint64_t sourceHeight = texture.GetHeight();
+    size_t sourcePitch = texture.GetPitch();
+
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = mode;
+    const auto &coloring = context.GetColoring();
+    auto blendFunc = context.GetBlendFunc();
+    PixelConverter::ConvertFunc unpackFunc = PixelConverter::GetConversionFunction(sourceFormat, PixelFormat::ARGB8888);
+    PixelConverter::ConvertFunc packFunc = PixelConverter::GetConversionFunction(PixelFormat::ARGB8888, targetFormat);
+
+    // horizontal taps of every clipped target column, relative to the first source column read
+    const size_t length = static_cast<size_t>(clip.endX - clip.startX);
+    columnOffsets.resize(length);
+    columnTaps.resize(length);
+    columnWeights.clear();
+    uint32_t firstColumn = 0, lastColumn = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        uint64_t dx = static_cast<uint64_t>(clip.startX - x) + i;
+        if (area)
+        {
+            // source span [start, end) covered by the target pixel, weights in 1/256 source pixels
+            uint64_t start = ((dx * sourceWidth) << 16) / dstWidth;
+            uint64_t end = (((dx + 1) * sourceWidth) << 16) / dstWidth;
+            uint32_t column = static_cast<uint32_t>(start >> 16);
+            columnOffsets[i] = column;
+            columnTaps[i] = 0;
+            for (uint64_t s = start; s < end; ++column)
             {
-                // Bilinear interpolation
-                int x0 = static_cast<int>(tx);
-                int y0 = static_cast<int>(ty);
-                int x1 = std::min(x0 + 1, static_cast<int>(sourceWidth - 1));
-                int y1 = std::min(y0 + 1, static_cast<int>(sourceHeight - 1));
-
-                float fx = tx - x0;
-                float fy = ty - y0;
-
-                // Get four neighboring pixels
-                const uint8_t *pixels[4] = {
-                    sourceData + y0 * sourcePitch + x0 * sourceInfo.bytesPerPixel, // (x0,y0)
-                    sourceData + y0 * sourcePitch + x1 * sourceInfo.bytesPerPixel, // (x1,y0)
-                    sourceData + y1 * sourcePitch + x0 * sourceInfo.bytesPerPixel, // (x0,y1)
-                    sourceData + y1 * sourcePitch + x1 * sourceInfo.bytesPerPixel  // (x1,y1)
-                };
-
-                // Convert all four pixels to ARGB8888 color format
-                Color colors[4];
-                for (int i = 0; i < 4; i++)
-                {
-                    colors[i] = Color(pixels[i], sourceFormat);
-                }
+                uint64_t next = std::min<uint64_t>(static_cast<uint64_t>(column + 1) << 16, end);
+                columnWeights.push_back(std::max<uint32_t>(static_cast<uint32_t>((next - s) >> 8), 1));
+                ++columnTaps[i];
+                s = next;
+            }
+            lastColumn = column - 1;
+        }
+        else
+        {
+            // pixel centers are aligned, x0 and an 8 bit fraction towards x0 + 1
+            int64_t position = static_cast<int64_t>((((2 * dx + 1) * sourceWidth) << 16) / (2 * dstWidth)) - 0x8000;
+            position = std::clamp<int64_t>(position, 0, static_cast<int64_t>((sourceWidth - 1) << 16));
+            columnOffsets[i] = static_cast<uint32_t>(position >> 16);
+            columnWeights.push_back(static_cast<uint32_t>(position >> 8) & 0xFF);
+            lastColumn = std::min<uint32_t>(columnOffsets[i] + 1, static_cast<uint32_t>(sourceWidth - 1));
+        }
+        if (i == 0)
+            firstColumn = columnOffsets[0];
+        columnOffsets[i] -= firstColumn;
+    }
+    const size_t unpackedLength = lastColumn - firstColumn + 1;
+
+    // two cached horizontally filtered rows, the finished row and the unpacked source row
+    filterRows.resize(length * 3 + unpackedLength);
+    uint32_t *cachedRows[2] = {filterRows.data(), filterRows.data() + length};
+    uint32_t cachedIndex[2] = {UINT32_MAX, UINT32_MAX};
+    uint32_t *finished = filterRows.data() + length * 2;
+    uint32_t *unpacked = finished + length;
+    if (area)
+        columnSums.resize(length * 4);
 
-                // Horizontal interpolation
-                Color top = Color::Lerp(colors[0], colors[1], fx);
-                Color bottom = Color::Lerp(colors[2], colors[3], fx);
+    auto filterRow = [&](uint32_t sy, uint32_t keep) -> const uint32_t *
+    {
+        for (int slot = 0; slot < 2; ++slot)
+            if (cachedIndex[slot] == sy)
+                return cachedRows[slot];
+        int slot = cachedIndex[0] == keep ? 1 : 0;
+        cachedIndex[slot] = sy;
+        uint32_t *out = cachedRows[slot];
 
-                // Vertical interpolation
-                Color finalColor = Color::Lerp(top, bottom, fy);
+        const uint8_t *sourceRow = sourceData + sy * sourcePitch + static_cast<size_t>(firstColumn) * sourceInfo.bytesPerPixel;
+        if (unpackFunc)
+            unpackFunc(sourceRow, reinterpret_cast<uint8_t *>(unpacked), unpackedLength);
+        else
+            for (size_t i = 0; i < unpackedLength; ++i)
+                Color(sourceRow + i * sourceInfo.bytesPerPixel, sourceFormat).ConvertTo(PixelFormat::ARGB8888, reinterpret_cast<uint8_t *>(unpacked + i));
 
-                finalColor.ConvertTo(targetFormat, dstBuffer);
-                break;
+        const uint32_t *weight = columnWeights.data();
+        for (size_t i = 0; i < length; ++i)
+        {
+            const uint32_t *pixel = unpacked + columnOffsets[i];
+            if (!area)
+            {
+                out[i] = BlendFunctions::LerpLanes(pixel[0], pixel[std::min<size_t>(columnOffsets[i] + 1, unpackedLength - 1) - columnOffsets[i]], *weight++);
+                continue;
             }
+            uint32_t sum[4] = {0, 0, 0, 0}, total = 0;
+            for (uint32_t t = 0; t < columnTaps[i]; ++t, ++weight)
+            {
+                const uint8_t *bytes = reinterpret_cast<const uint8_t *>(pixel + t);
+                for (int c = 0; c < 4; ++c)
+                    sum[c] += bytes[c] * *weight;
+                total += *weight;
             }
+            // divide by the covered width through a 0.24 fixed point reciprocal
+            uint64_t reciprocal = (1ull << 24) / total;
+            uint8_t *result = reinterpret_cast<uint8_t *>(out + i);
+            for (int c = 0; c < 4; ++c)
+                result[c] = static_cast<uint8_t>(std::min<uint64_t>((sum[c] * reciprocal + (1ull << 23)) >> 24, 255));
+        }
+        return out;
+    };
 
-            // Get destination pixel location
-            uint8_t *dstPixel = targetData +
-                                dy * targetPitch +
-                                dx * targetInfo.bytesPerPixel;
-
-            // Handle blending
-            if (bc.mode != BlendMode::NOBLEND)
+    uint8_t *targetRow = targetData + static_cast<size_t>(clip.startY) * targetPitch + static_cast<size_t>(clip.startX) * targetInfo.bytesPerPixel;
+    for (int32_t dy = clip.startY; dy < clip.endY; ++dy, targetRow += targetPitch)
+    {
+        uint64_t row = static_cast<uint64_t>(dy - y);
+        const uint32_t *filtered = finished;
+        if (area)
+        {
+            uint64_t start = ((row * sourceHeight) << 16) / dstHeight;
+            uint64_t end = (((row + 1) * sourceHeight) << 16) / dstHeight;
+            if ((start >> 16) == ((end - 1) >> 16))
             {
-                context.GetBlendFunc()(dstPixel, dstBuffer, 1, targetInfo, sourceInfo, context.GetColoring(),false,bc);
+                // upscaled rows covering a single source row use it as is
+                filtered = filterRow(static_cast<uint32_t>(start >> 16), static_cast<uint32_t>(start >> 16) - 1);
+            }
+            else
+            {
+                std::fill(columnSums.begin(), columnSums.end(), 0);
+                uint32_t total = 0;
+                for (uint64_t s = start; s < end;)
+                {
+                    uint32_t sy = static_cast<uint32_t>(s >> 16);
+                    uint64_t next = std::min<uint64_t>(static_cast<uint64_t>(sy + 1) << 16, end);
+                    uint32_t weight = std::max<uint32_t>(static_cast<uint32_t>((next - s) >> 8), 1);
+                    // evicting the previous row keeps the last one cached, it is shared with the next target row
+                    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(filterRow(sy, sy - 1));
+                    for (size_t i = 0; i < length * 4; ++i)
+                        columnSums[i] += bytes[i] * weight;
+                    total += weight;
+                    s = next;
+                }
+                uint64_t reciprocal = (1ull << 24) / total;
+                uint8_t *result = reinterpret_cast<uint8_t *>(finished);
+                for (size_t i = 0; i < length * 4; ++i)
+                    result[i] = static_cast<uint8_t>(std::min<uint64_t>((columnSums[i] * reciprocal + (1ull << 23)) >> 24, 255));
             }
+        }
+        else
+        {
+            int64_t position = static_cast<int64_t>((((2 * row + 1) * sourceHeight) << 16) / (2 * dstHeight)) - 0x8000;
+            position = std::clamp<int64_t>(position, 0, static_cast<int64_t>((sourceHeight - 1) << 16));
+            uint32_t y0 = static_cast<uint32_t>(position >> 16);
+            uint32_t fraction = static_cast<uint32_t>(position >> 8) & 0xFF;
+            const uint32_t *top = filterRow(y0, y0 + 1);
+            if (fraction == 0)
+                filtered = top;
             else
             {
-                MemHandler::MemCopy(dstPixel, dstBuffer, targetInfo.bytesPerPixel);
+                const uint32_t *bottom = filterRow(y0 + 1, y0);
+                for (size_t i = 0; i < length; ++i)
+                    finished[i] = BlendFunctions::LerpLanes(top[i], bottom[i], fraction);
             }
         }
+
+        const uint8_t *filteredBytes = reinterpret_cast<const uint8_t *>(filtered);
+        if (bc.mode == BlendMode::NOBLEND)
+        {
+            if (packFunc)
+                packFunc(filteredBytes, targetRow, length);
+            else
+                for (size_t i = 0; i < length; ++i)
+                    Color(filteredBytes + i * 4, PixelFormat::ARGB8888).ConvertTo(targetFormat, targetRow + i * targetInfo.bytesPerPixel);
+            continue;
+        }
+        for (size_t done = 0; done < length; done += MAXROWLENGTH)
+        {
+            size_t chunk = std::min<size_t>(MAXROWLENGTH, length - done);
+            blendFunc(targetRow + done * targetInfo.bytesPerPixel, filteredBytes + done * 4, chunk,
+                      targetInfo, filteredInfo, coloring, false, bc);
+        }
     }
-}
\ No newline at end of file
+}
+
+void ScaleTextureRenderer::DrawTexture(const RLETexture &texture, int32_t x, int32_t y,
+                                       float scaleX, float scaleY)
+{
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || texture.IsEmpty() || scaleX <= 0 || scaleY <= 0)
+        return;
+
+    if (scaleX == 1 && scaleY == 1)
+    {
+        context.basicTextureRenderer.DrawTexture(texture, x, y);
+        return;
+    }
+
+    PixelFormat targetFormat = targetTexture->GetFormat();
+    PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    uint32_t sourceWidth = texture.GetWidth();
+    uint32_t sourceHeight = texture.GetHeight();
+
+    uint32_t dstWidth = static_cast<uint32_t>(sourceWidth * scaleX);
+    uint32_t dstHeight = static_cast<uint32_t>(sourceHeight * scaleY);
+    if (dstWidth == 0 || dstHeight == 0)
+        return;
+
+    ClippingArea clip;
+    if (!ClipToTarget(x, y, dstWidth, dstHeight, clip))
+        return;
+
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = context.BlendModeToUse(sourceInfo);
+    const auto &coloring = context.GetColoring();
+    auto blendFunc = context.GetBlendFunc();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
+    bool copyOpaque = convertFunc && BlendFunctions::OpaqueSourceIsCopy(bc, coloring);
+    if (bc.mode == BlendMode::NOBLEND && !convertFunc)
+        return;
+
+    // same nearest neighbour mapping as the Texture path (DrawReplicated or DrawNearest), monotonic in dx
+    const bool wholeFactors = scaleX == std::floor(scaleX) && scaleY == std::floor(scaleY);
+    const NearestAxis columns(sourceWidth, dstWidth, wholeFactors ? static_cast<uint32_t>(scaleX) : 0);
+    const NearestAxis rows(sourceHeight, dstHeight, wholeFactors ? static_cast<uint32_t>(scaleY) : 0);
+    auto sourceColumn = [&](int32_t dx) -> uint32_t
+    {
+        return columns(static_cast<uint32_t>(dx - x));
+    };
+
+    const uint32_t firstColumn = sourceColumn(clip.startX);
+    const uint32_t lastColumn = sourceColumn(clip.endX - 1);
+    uint8_t gathered[MAXROWLENGTH * MAXBYTESPERPIXEL];
+
+    for (int32_t dy = clip.startY; dy < clip.endY; ++dy)
+    {
+        uint32_t sy = rows(static_cast<uint32_t>(dy - y));
+        uint8_t *targetRow = targetData + static_cast<size_t>(dy) * targetPitch;
+        int32_t dx = clip.startX;
+
+        texture.ForEachRun(sy, firstColumn, lastColumn + 1, [&](const RLERun &run)
+        {
+            // target columns sampling this run form one contiguous span
+            int32_t spanStart = dx;
+            uint32_t runEnd = run.start + run.length;
+            while (dx < clip.endX && sourceColumn(dx) < runEnd)
+                ++dx;
+
+            if (run.type == RLERunType::TRANSPARENT)
+            {
+                if (bc.mode == BlendMode::NOBLEND)
+                    WriteTransparent(convertFunc, targetRow + static_cast<size_t>(spanStart) * targetInfo.bytesPerPixel,
+                                     dx - spanStart, targetInfo.bytesPerPixel);
+                return;
+            }
+
+            bool convert = bc.mode == BlendMode::NOBLEND || (run.type == RLERunType::OPAQUE && copyOpaque);
+            for (int32_t chunkStart = spanStart; chunkStart < dx; chunkStart += MAXROWLENGTH)
+            {
+                int32_t chunkLength = std::min(dx - chunkStart, static_cast<int32_t>(MAXROWLENGTH));
+                for (int32_t i = 0; i < chunkLength; ++i)
+                {
+                    const uint8_t *srcPixel = run.pixels + static_cast<size_t>(sourceColumn(chunkStart + i) - run.start) * sourceInfo.bytesPerPixel;
+                    MemHandler::MemCopy(gathered + i * sourceInfo.bytesPerPixel, srcPixel, sourceInfo.bytesPerPixel);
+                }
+
+                uint8_t *dst = targetRow + static_cast<size_t>(chunkStart) * targetInfo.bytesPerPixel;
+                if (convert)
+                    convertFunc(gathered, dst, chunkLength);
+                else
+                    blendFunc(dst, gathered, chunkLength, targetInfo, sourceInfo, coloring, false, bc);
+            }
+        });
+    }
+}
+
+void ScaleTextureRenderer::DrawTexture(StreamedTexture &texture, int32_t x, int32_t y,
+                                       float scaleX, float scaleY)
+{
+    if (!texture.IsOpen() || scaleX <= 0 || scaleY <= 0)
+        return;
+
+    if (scaleX == 1 && scaleY == 1)
+    {
+        context.basicTextureRenderer.DrawTexture(texture, x, y);
+        return;
+    }
+
+    const float scaleMatrix[3][3] = {
+        {scaleX, 0.0f, static_cast<float>(x)},
+        {0.0f, scaleY, static_cast<float>(y)},
+        {0.0f, 0.0f, 1.0f}};
+    context.transformedTextureRenderer.DrawTexture(texture, scaleMatrix);
+}
@@ -3,6 +3,11 @@
 
 #include "../RendererBase.h"
 #include "../../data/Texture.h"
+#include "../../data/RLETexture.h"
+#include "../../data/StreamedTexture.h"
+#include "../../data/BlendMode/BlendMode.h"
+#include <vector>
+#include <cstring>
 
 namespace Tergos2D
 {
@@ -13,10 +18,79 @@ namespace Tergos2D
         ~ScaleTextureRenderer() = default;
 
 
-        void DrawTexture(Texture &texture, int16_t x, int16_t y,
+        /// @brief Draws the texture scaled by scaleX, scaleY with the context's sampling method.
+        /// With a scaling cache set on the context, repeated draws at the same size blit a cached resampled copy
+        void DrawTexture(Texture &texture, int32_t x, int32_t y,
+                         float scaleX, float scaleY);
+        /// @brief Nearest neighbour scaling of an RLE texture, decoded while drawing. Pixels are mapped like the nearest
+        /// neighbour Texture path. Transparent runs are skipped when blending, the sampled pixels of other runs are
+        /// gathered and converted or blended in bulk
+        void DrawTexture(const RLETexture &texture, int32_t x, int32_t y,
+                         float scaleX, float scaleY);
+        /// @brief Scales a streamed texture through the transformed renderer, which maps every target
+        /// pixel back into exactly one tile so tile borders stay seamless
+        void DrawTexture(StreamedTexture &texture, int32_t x, int32_t y,
                          float scaleX, float scaleY);
         private:
+        /// @brief Source pixel a nearest neighbour draw samples at a target offset along one axis. Whole factors
+        /// replicate (offset / factor, as DrawReplicated), other scales round on the 16.16 grid of DrawNearest
+        struct NearestAxis
+        {
+            NearestAxis(uint32_t sourceSize, uint32_t dstSize, uint32_t wholeFactor)
+                : factor(wholeFactor), step((static_cast<uint64_t>(sourceSize) << 16) / dstSize), last(sourceSize - 1)
+            {
+            }
+
+            uint32_t operator()(uint32_t offset) const
+            {
+                uint64_t source = factor ? offset / factor : (offset * step + 0x8000) >> 16;
+                return source < last ? static_cast<uint32_t>(source) : last;
+            }
+
+            uint32_t factor; // 0 for scales that are not whole numbers
+            uint64_t step;
+            uint32_t last;
+        };
+
+        /// @brief Scales texture into target at x, y. Draws (copy false) use the context's clipping, blending and
+        /// coloring, copies (copy true) convert into the target as is, which is how scaling cache entries are filled
+        void Resample(Texture &texture, Texture &target, int32_t x, int32_t y, float scaleX, float scaleY, bool copy);
+        /// @brief Nearest neighbour scaling of an already clipped area. Source columns are precomputed with a 16.16
+        /// fixed point DDA, each target row is gathered once and converted or blended as one span, and target rows
+        /// sampling the same source row reuse the previous result
+        void DrawNearest(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t dstWidth, uint32_t dstHeight,
+                         const ClippingArea &clip, BlendMode mode);
+
+        /// @brief Nearest neighbour scaling by whole factors. Every source pixel of a row is widened to factorX copies once,
+        /// converted or blended as one span, and the remaining rows of each block copy the first one
+        void DrawReplicated(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t factorX, uint32_t factorY,
+                            const ClippingArea &clip, BlendMode mode);
+
+        /// @brief Writes factor copies of each of the count source pixels, T is an integer as wide as one pixel
+        template <typename T>
+        static void WidenRow(const uint8_t *src, uint8_t *dst, size_t count, uint32_t factor)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                T value;
+                std::memcpy(&value, src + i * sizeof(T), sizeof(T));
+                for (uint32_t k = 0; k < factor; ++k, dst += sizeof(T))
+                    std::memcpy(dst, &value, sizeof(T));
+            }
+        }
+
+        /// @brief Separable bilinear or area averaging scaling of an already clipped area. Source rows are unpacked to
+        /// ARGB8888 and filtered horizontally into a two row cache with 8 bit fixed point weights, then combined vertically.
+        /// Area averaging weights every source pixel by the part of it a target pixel covers, so downscales do not alias
+        void DrawFiltered(const Texture &texture, Texture &target, int32_t x, int32_t y, uint32_t dstWidth, uint32_t dstHeight,
+                          const ClippingArea &clip, BlendMode mode, bool area);
 
+        std::vector<uint32_t> columnOffsets;
+        std::vector<uint8_t> rowBuffer;
+        std::vector<uint32_t> columnTaps;
+        std::vector<uint32_t> columnWeights;
+        std::vector<uint32_t> columnSums;
+        std::vector<uint32_t> filterRows;
     };
 
 }
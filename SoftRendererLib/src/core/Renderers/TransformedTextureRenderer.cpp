@@ -5,11 +5,114 @@
 #include "../../data/BlendMode/BlendFunctions.h"
 #include "../../data/PixelFormat/PixelConverter.h"
 #include "../RenderContext2D.h"
+#include "AffineSampler.h"
+#include "RotateBlit.h"
+#include "EdgeCoverage.h"
 #include <float.h>
 #include <math.h>
 #include <cstdio>
 using namespace Tergos2D;
 
+namespace
+{
+    /// @brief 32.32 fixed point value of v, exact for every float in the range of texture coordinates
+    inline int64_t ToFixed(float v)
+    {
+        return static_cast<int64_t>(static_cast<double>(v) * 4294967296.0);
+    }
+
+    /// @brief True for whole scale factors with an exact float reciprocal (1, 2, 4, ...). The inverse mapping then
+    /// lands exactly on whole source pixels, the same ones pixel replication picks
+    inline bool IsExactWholeFactor(float factor)
+    {
+        int exponent;
+        return factor >= 1 && std::frexp(factor, &exponent) == 0.5f;
+    }
+
+    /// @brief Copies one texel, the fixed size per case keeps each copy a single load and store
+    inline void CopyTexel(uint8_t *dst, const uint8_t *src, size_t bytesPerPixel)
+    {
+        switch (bytesPerPixel)
+        {
+        case 4:
+            std::memcpy(dst, src, 4);
+            break;
+        case 3:
+            std::memcpy(dst, src, 3);
+            break;
+        case 2:
+            std::memcpy(dst, src, 2);
+            break;
+        default:
+            *dst = *src;
+            break;
+        }
+    }
+
+    /// @brief 32.32 fixed point value of a projected coordinate, far off values are clamped before they overflow
+    inline int64_t ToFixedClamped(double v)
+    {
+        return static_cast<int64_t>(std::clamp(v, -1073741824.0, 1073741824.0) * 4294967296.0);
+    }
+
+    /// @brief Texels a bilinear filter reads from, positions are clamped to [minU, maxU] x [minV, maxV]
+    /// and the right and bottom neighbours to the last column and row inside that range
+    struct FilterSource
+    {
+        PixelAddressing texels;
+        PixelFormat format;
+        PixelConverter::ConvertFunc unpackFunc; // to ARGB8888, nullptr converts through Color
+        int64_t minU, maxU, minV, maxV;
+    };
+
+    /// @brief Bilinear filters the 32.32 positions (us[i], vs[i]) into count ARGB8888 pixels. The four neighbours are
+    /// unpacked to ARGB8888 and interpolated with 8 bit weights, so every source format is filtered the same way
+    void FilterTexels(const FilterSource &source, const int64_t *us, const int64_t *vs, int count, uint32_t *out)
+    {
+        const size_t bpp = source.texels.bytesPerPixel;
+        const uint32_t lastX = static_cast<uint32_t>(source.maxU >> 32);
+        const uint32_t lastY = static_cast<uint32_t>(source.maxV >> 32);
+        uint8_t neighbours[4][MAX_BUFFER_SIZE * MAXBYTESPERPIXEL];
+        uint32_t texels[4][MAX_BUFFER_SIZE];
+        uint32_t weightX[MAX_BUFFER_SIZE];
+        uint32_t weightY[MAX_BUFFER_SIZE];
+
+        // fetch the four neighbours of every pixel and its 8 bit fractions
+        for (int i = 0; i < count; ++i)
+        {
+            int64_t clampedU = std::clamp(us[i], source.minU, source.maxU);
+            int64_t clampedV = std::clamp(vs[i], source.minV, source.maxV);
+            uint32_t x0 = static_cast<uint32_t>(clampedU >> 32);
+            uint32_t y0 = static_cast<uint32_t>(clampedV >> 32);
+            uint32_t x1 = std::min(x0 + 1, lastX);
+            uint32_t y1 = std::min(y0 + 1, lastY);
+            weightX[i] = static_cast<uint32_t>(clampedU >> 24) & 0xFF;
+            weightY[i] = static_cast<uint32_t>(clampedV >> 24) & 0xFF;
+            CopyTexel(neighbours[0] + i * bpp, source.texels.At(x0, y0), bpp);
+            CopyTexel(neighbours[1] + i * bpp, source.texels.At(x1, y0), bpp);
+            CopyTexel(neighbours[2] + i * bpp, source.texels.At(x0, y1), bpp);
+            CopyTexel(neighbours[3] + i * bpp, source.texels.At(x1, y1), bpp);
+        }
+
+        for (int k = 0; k < 4; ++k)
+        {
+            if (source.unpackFunc)
+                source.unpackFunc(neighbours[k], reinterpret_cast<uint8_t *>(texels[k]), count);
+            else
+                for (int i = 0; i < count; ++i)
+                    Color(neighbours[k] + i * bpp, source.format).ConvertTo(PixelFormat::ARGB8888, reinterpret_cast<uint8_t *>(texels[k] + i));
+        }
+
+        // two 16 bit lanes per word interpolate all four channels at once
+        for (int i = 0; i < count; ++i)
+        {
+            uint32_t top = BlendFunctions::LerpLanes(texels[0][i], texels[1][i], weightX[i]);
+            uint32_t bottom = BlendFunctions::LerpLanes(texels[2][i], texels[3][i], weightX[i]);
+            out[i] = BlendFunctions::LerpLanes(top, bottom, weightY[i]);
+        }
+    }
+}
+
 TransformedTextureRenderer::TransformedTextureRenderer(RenderContext2D &context) : RendererBase(context)
 {
 }
@@ -22,30 +125,252 @@ void TransformedTextureRenderer::DrawTexture(Texture &texture, const float trans
     {
         endX = texture.GetWidth();
         endY = texture.GetHeight();
+        // axis aligned scales at whole pixel positions are served from the scaling cache. Only draws the
+        // ScaleTextureRenderer reproduces pixel for pixel are routed, with or without a cached copy: nearest
+        // sampling through the default draw function, exact whole factors, linear sources and no smoothed edges
+        const float (*m)[3] = transformationMatrix;
+        const DrawTexturePointer nearestDraw = DrawTexture;
+        const bool defaultNearest = m_drawTexture == nearestDraw || m_drawTexture == DrawTextureSamplingSupp;
+        if (context.GetScalingCache() && defaultNearest && context.GetSamplingMethod() == SamplingMethod::NEAREST &&
+            !context.IsEdgeAntialiasingEnabled() && texture.GetLayout() == TextureLayout::LINEAR &&
+            m[0][1] == 0 && m[1][0] == 0 && m[2][0] == 0 && m[2][1] == 0 && m[2][2] == 1 &&
+            IsExactWholeFactor(m[0][0]) && IsExactWholeFactor(m[1][1]) &&
+            m[0][2] == std::floor(m[0][2]) && m[1][2] == std::floor(m[1][2]))
+        {
+            context.scaleTextureRenderer.DrawTexture(texture, static_cast<int32_t>(m[0][2]), static_cast<int32_t>(m[1][2]), m[0][0], m[1][1]);
+            return;
+        }
     }
     m_drawTexture(texture,transformationMatrix, context,startX,StartY,endX,endY);
 }
+void TransformedTextureRenderer::DrawTexture(StreamedTexture &texture, const float transformationMatrix[3][3])
+{
+    auto targetTexture = context.GetDrawTarget();
+    if (!targetTexture || !texture.IsOpen())
+        return;
+
+    ClippingArea visible;
+    if (!ClipToTarget(0, 0, targetTexture->GetWidth(), targetTexture->GetHeight(), visible))
+        return;
+
+    // Define the inverse transformation matrix
+    float invMatrix[3][3];
+    float det = transformationMatrix[0][0] * (transformationMatrix[1][1] * transformationMatrix[2][2] - transformationMatrix[1][2] * transformationMatrix[2][1]) -
+                transformationMatrix[0][1] * (transformationMatrix[1][0] * transformationMatrix[2][2] - transformationMatrix[1][2] * transformationMatrix[2][0]) +
+                transformationMatrix[0][2] * (transformationMatrix[1][0] * transformationMatrix[2][1] - transformationMatrix[1][1] * transformationMatrix[2][0]);
+    if (det == 0.0f)
+        return;
+    float invDet = 1.0f / det;
+    invMatrix[0][0] = (transformationMatrix[1][1] * transformationMatrix[2][2] - transformationMatrix[1][2] * transformationMatrix[2][1]) * invDet;
+    invMatrix[0][1] = (transformationMatrix[0][2] * transformationMatrix[2][1] - transformationMatrix[0][1] * transformationMatrix[2][2]) * invDet;
+    invMatrix[0][2] = (transformationMatrix[0][1] * transformationMatrix[1][2] - transformationMatrix[0][2] * transformationMatrix[1][1]) * invDet;
+    invMatrix[1][0] = (transformationMatrix[1][2] * transformationMatrix[2][0] - transformationMatrix[1][0] * transformationMatrix[2][2]) * invDet;
+    invMatrix[1][1] = (transformationMatrix[0][0] * transformationMatrix[2][2] - transformationMatrix[0][2] * transformationMatrix[2][0]) * invDet;
+    invMatrix[1][2] = (transformationMatrix[0][2] * transformationMatrix[1][0] - transformationMatrix[0][0] * transformationMatrix[1][2]) * invDet;
+    invMatrix[2][0] = (transformationMatrix[1][0] * transformationMatrix[2][1] - transformationMatrix[1][1] * transformationMatrix[2][0]) * invDet;
+    invMatrix[2][1] = (transformationMatrix[0][1] * transformationMatrix[2][0] - transformationMatrix[0][0] * transformationMatrix[2][1]) * invDet;
+    invMatrix[2][2] = (transformationMatrix[0][0] * transformationMatrix[1][1] - transformationMatrix[0][1] * transformationMatrix[1][0]) * invDet;
+
+    auto toSource = [&invMatrix](float x, float y, float &u, float &v)
+    {
+        float w = invMatrix[2][0] * x + invMatrix[2][1] * y + invMatrix[2][2];
+        u = (invMatrix[0][0] * x + invMatrix[0][1] * y + invMatrix[0][2]) / w;
+        v = (invMatrix[1][0] * x + invMatrix[1][1] * y + invMatrix[1][2]) / w;
+    };
+
+    const float EPSILON = 0.0001f;
+    bool affine = std::abs(transformationMatrix[2][0]) < EPSILON &&
+                  std::abs(transformationMatrix[2][1]) < EPSILON;
+
+    uint32_t tileSize = texture.GetTileSize();
+    uint32_t firstTileX = 0;
+    uint32_t firstTileY = 0;
+    uint32_t lastTileX = texture.GetTilesX() - 1;
+    uint32_t lastTileY = texture.GetTilesY() - 1;
+    if (affine)
+    {
+        // only tiles behind the visible rectangle can be touched
+        float minU = FLT_MAX, minV = FLT_MAX, maxU = -FLT_MAX, maxV = -FLT_MAX;
+        const float corners[4][2] = {{static_cast<float>(visible.startX), static_cast<float>(visible.startY)},
+                                     {static_cast<float>(visible.endX), static_cast<float>(visible.startY)},
+                                     {static_cast<float>(visible.startX), static_cast<float>(visible.endY)},
+                                     {static_cast<float>(visible.endX), static_cast<float>(visible.endY)}};
+        for (const auto &corner : corners)
+        {
+            float u, v;
+            toSource(corner[0], corner[1], u, v);
+            minU = std::min(minU, u);
+            maxU = std::max(maxU, u);
+            minV = std::min(minV, v);
+            maxV = std::max(maxV, v);
+        }
+        if (maxU < 0.0f || maxV < 0.0f || minU >= texture.GetWidth() || minV >= texture.GetHeight())
+            return;
+        firstTileX = static_cast<uint32_t>(std::max(minU, 0.0f)) / tileSize;
+        firstTileY = static_cast<uint32_t>(std::max(minV, 0.0f)) / tileSize;
+        lastTileX = std::min(lastTileX, static_cast<uint32_t>(std::min(maxU, static_cast<float>(texture.GetWidth() - 1))) / tileSize);
+        lastTileY = std::min(lastTileY, static_cast<uint32_t>(std::min(maxV, static_cast<float>(texture.GetHeight() - 1))) / tileSize);
+    }
+
+    PixelFormat sourceFormat = texture.GetFormat();
+    PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetTexture->GetFormat());
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetTexture->GetFormat());
+    if (!convertFunc)
+        return;
+
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = context.BlendModeToUse(sourceInfo);
+
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
+    const int maxPos = MAX_BUFFER_SIZE;
+    uint8_t buffer[maxPos * MAXBYTESPERPIXEL];
+    int pos = 0;
+    uint8_t *targetPixel = nullptr;
+
+    auto flush = [&]()
+    {
+        if (pos == 0)
+            return;
+        if (bc.mode == BlendMode::NOBLEND)
+            convertFunc(buffer, targetPixel, pos);
+        else
+            context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(), false, bc);
+        pos = 0;
+    };
+
+    for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+    {
+        for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+        {
+            float originX = static_cast<float>(tileX) * tileSize;
+            float originY = static_cast<float>(tileY) * tileSize;
+            float tileEndX = originX + std::min(tileSize, texture.GetWidth() - tileX * tileSize);
+            float tileEndY = originY + std::min(tileSize, texture.GetHeight() - tileY * tileSize);
+
+            // target rectangle covered by the tile, the whole visible area if a corner is behind the viewer
+            int32_t startX = visible.startX, startY = visible.startY, endX = visible.endX, endY = visible.endY;
+            float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+            bool bounded = true;
+            const float corners[4][2] = {{originX, originY}, {tileEndX, originY}, {originX, tileEndY}, {tileEndX, tileEndY}};
+            for (const auto &corner : corners)
+            {
+                float w = transformationMatrix[2][0] * corner[0] + transformationMatrix[2][1] * corner[1] + transformationMatrix[2][2];
+                if (w <= EPSILON)
+                {
+                    bounded = false;
+                    break;
+                }
+                float px = (transformationMatrix[0][0] * corner[0] + transformationMatrix[0][1] * corner[1] + transformationMatrix[0][2]) / w;
+                float py = (transformationMatrix[1][0] * corner[0] + transformationMatrix[1][1] * corner[1] + transformationMatrix[1][2]) / w;
+                minX = std::min(minX, px);
+                maxX = std::max(maxX, px);
+                minY = std::min(minY, py);
+                maxY = std::max(maxY, py);
+            }
+            if (bounded)
+            {
+                startX = std::max(startX, ClampCoordinate(std::floor(minX)));
+                startY = std::max(startY, ClampCoordinate(std::floor(minY)));
+                endX = std::min(endX, ClampCoordinate(std::ceil(maxX)) + 1);
+                endY = std::min(endY, ClampCoordinate(std::ceil(maxY)) + 1);
+            }
+            if (startX >= endX || startY >= endY)
+                continue;
+
+            Texture *tile = texture.GetTile(tileX, tileY);
+            if (!tile)
+                continue;
+            const uint8_t *tileData = tile->GetData();
+            size_t tilePitch = tile->GetPitch();
+            uint32_t baseX = tileX * tileSize;
+            uint32_t baseY = tileY * tileSize;
+
+            // every target pixel is mapped with the same global inverse and drawn by the one
+            // tile that contains its source position, so neighbouring tiles never leave gaps
+            for (int32_t y = startY; y < endY; ++y)
+            {
+                for (int32_t x = startX; x < endX; ++x)
+                {
+                    float u, v;
+                    toSource(static_cast<float>(x), static_cast<float>(y), u, v);
+                    if (!(u >= originX && u < tileEndX && v >= originY && v < tileEndY))
+                    {
+                        flush();
+                        continue;
+                    }
+                    if (pos == 0)
+                        targetPixel = targetData + y * targetPitch + x * targetInfo.bytesPerPixel;
+
+                    const uint8_t *sourcePixel = tileData + (static_cast<uint32_t>(v) - baseY) * tilePitch +
+                                                 (static_cast<uint32_t>(u) - baseX) * sourceInfo.bytesPerPixel;
+                    std::memcpy(buffer + sourceInfo.bytesPerPixel * pos, sourcePixel, sourceInfo.bytesPerPixel);
+                    if (++pos == maxPos)
+                        flush();
+                }
+                flush();
+            }
+        }
+    }
+}
+
+Texture &Tergos2D::TransformedTextureRenderer::SelectMip(Texture &texture, const float transformationMatrix[3][3], float mipMatrix[3][3],
+    int &startX, int &startY, int &endX, int &endY)
+{
+    if (texture.GetMipCount() <= 1 || transformationMatrix[2][0] != 0.0f || transformationMatrix[2][1] != 0.0f)
+        return texture;
+
+    float det = transformationMatrix[0][0] * transformationMatrix[1][1] - transformationMatrix[0][1] * transformationMatrix[1][0];
+    uint32_t level = texture.SelectMip(std::sqrt(std::abs(det)));
+    if (level == 0)
+        return texture;
+
+    Texture &mip = texture.GetMip(level);
+    // source coordinates of the mip are level 0 coordinates divided by these factors
+    float factorX = static_cast<float>(texture.GetWidth()) / mip.GetWidth();
+    float factorY = static_cast<float>(texture.GetHeight()) / mip.GetHeight();
+    for (int row = 0; row < 3; ++row)
+    {
+        mipMatrix[row][0] = transformationMatrix[row][0] * factorX;
+        mipMatrix[row][1] = transformationMatrix[row][1] * factorY;
+        mipMatrix[row][2] = transformationMatrix[row][2];
+    }
+    startX = static_cast<int>(std::floor(startX / factorX));
+    startY = static_cast<int>(std::floor(startY / factorY));
+    endX = static_cast<int>(std::ceil(endX / factorX));
+    endY = static_cast<int>(std::ceil(endY / factorY));
+    return mip;
+}
+
 void Tergos2D::TransformedTextureRenderer::DrawTexture(Texture &texture, const float transformationMatrix[3][3], RenderContext2D &context, int tstartX, int tStartY, int tendX, int tendY)
 {
-    auto targetTexture = context.GetTargetTexture();
+    auto targetTexture = context.GetDrawTarget();
     if (!targetTexture || !texture.GetData())
     {
         return;
     }
 
+    float mipMatrix[3][3];
+    Texture &mip = SelectMip(texture, transformationMatrix, mipMatrix, tstartX, tStartY, tendX, tendY);
+    if (&mip != &texture)
+    {
+        DrawTexture(mip, mipMatrix, context, tstartX, tStartY, tendX, tendY);
+        return;
+    }
+
      // Get texture information
      PixelFormat sourceFormat = texture.GetFormat();
      PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
-     uint8_t *sourceData = texture.GetData();
-     uint16_t sourceWidth = texture.GetWidth();
-     uint16_t sourceHeight = texture.GetHeight();
-     size_t sourcePitch = texture.GetPitch();
+     PixelAddressing source = texture.GetAddressing();
+     uint32_t sourceWidth = texture.GetWidth();
+     uint32_t sourceHeight = texture.GetHeight();
 
      PixelFormat targetFormat = targetTexture->GetFormat();
      PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
      uint8_t *targetData = targetTexture->GetData();
-     uint16_t targetWidth = targetTexture->GetWidth();
-     uint16_t targetHeight = targetTexture->GetHeight();
+     uint32_t targetWidth = targetTexture->GetWidth();
+     uint32_t targetHeight = targetTexture->GetHeight();
      size_t targetPitch = targetTexture->GetPitch();
 
      BlendContext bc = context.GetBlendContext();
@@ -82,116 +407,136 @@ void Tergos2D::TransformedTextureRenderer::DrawTexture(Texture &texture, const f
             PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
             if (!convertFunc) return;
 
-            // Calculate destination coordinates based on rotation
-            int16_t destX = static_cast<int16_t>(transformationMatrix[0][2]);
-            int16_t destY = static_cast<int16_t>(transformationMatrix[1][2]);
+            int32_t destX = ClampCoordinate(transformationMatrix[0][2]);
+            int32_t destY = ClampCoordinate(transformationMatrix[1][2]);
+            // the basic renderer copies whole rows, tiled textures take the rotation path below
+            if (angle == 0 && texture.GetLayout() == TextureLayout::LINEAR)
+            {
+                context.basicTextureRenderer.DrawTexture(texture,destX,destY);
+                return;
+            }
 
-            // Adjust clipping based on rotation
-            int16_t startX = destX;
-            int16_t startY = destY;
-            int16_t width = sourceWidth;
-            int16_t height = sourceHeight;
+            // drawn part of the source and the target rectangle it lands on
+            const int64_t sourceX0 = std::max(tstartX, 0);
+            const int64_t sourceY0 = std::max(tStartY, 0);
+            const int64_t sourceX1 = std::min<int64_t>(tendX, sourceWidth);
+            const int64_t sourceY1 = std::min<int64_t>(tendY, sourceHeight);
+            if (sourceX0 >= sourceX1 || sourceY0 >= sourceY1)
+                return;
 
+            int64_t startX = destX + sourceX0, endX = destX + sourceX1;
+            int64_t startY = destY + sourceY0, endY = destY + sourceY1;
             switch (angle)
             {
-                case 0:   // 0 degrees
-                    context.basicTextureRenderer.DrawTexture(texture,destX,destY);
-                    return;
+                case 90:
+                    startX = destX - sourceY1;
+                    endX = destX - sourceY0;
+                    startY = destY + sourceX0;
+                    endY = destY + sourceX1;
                     break;
-                case 90:  // 90 degrees
-                    startX = destX - sourceHeight;
-                    std::swap(width, height);
+                case 180:
+                    startX = destX - sourceX1;
+                    endX = destX - sourceX0;
+                    startY = destY - sourceY1;
+                    endY = destY - sourceY0;
                     break;
-                case 180: // 180 degrees
-                    startX = destX - sourceWidth;
-                    startY = destY - sourceHeight;
-                    break;
-                case 270: // 270 degrees
-                    startY = destY - sourceWidth;
-                    std::swap(width, height);
+                case 270:
+                    startX = destX + sourceY0;
+                    endX = destX + sourceY1;
+                    startY = destY - sourceX1;
+                    endY = destY - sourceX0;
                     break;
             }
 
-            // Apply clipping
+            startX = std::max<int64_t>(startX, 0);
+            startY = std::max<int64_t>(startY, 0);
+            endX = std::min<int64_t>(endX, targetWidth);
+            endY = std::min<int64_t>(endY, targetHeight);
             if (context.IsClippingEnabled())
             {
                 auto clippingArea = context.GetClippingArea();
-                startX = std::max(startX, static_cast<int16_t>(clippingArea.startX));
-                startY = std::max(startY, static_cast<int16_t>(clippingArea.startY));
-                width = std::min(width, static_cast<int16_t>(clippingArea.endX - startX));
-                height = std::min(height, static_cast<int16_t>(clippingArea.endY - startY));
+                startX = std::max<int64_t>(startX, clippingArea.startX);
+                startY = std::max<int64_t>(startY, clippingArea.startY);
+                endX = std::min<int64_t>(endX, clippingArea.endX);
+                endY = std::min<int64_t>(endY, clippingArea.endY);
             }
+            if (startX >= endX || startY >= endY)
+                return;
 
-            // Optimized copy for each rotation
-            const int maxPos = MAX_BUFFER_SIZE;
-            uint8_t buffer[maxPos*4];  // Reuse the buffer from original code
-            int pos = 0;
-            uint8_t* targetPixel = nullptr;
-            for (int16_t y = 0; y < height; ++y)
+            // source texel of target pixel (x, y)
+            auto sourceTexel = [&](int64_t x, int64_t y) -> const uint8_t *
             {
-                for (int16_t x = 0; x < width; ++x)
+                switch (angle)
                 {
-                    uint16_t sourceX = 0;
-                    uint16_t sourceY = 0;
-                    switch (angle)
+                    case 90:
+                        return source.At(static_cast<uint32_t>(y - destY), static_cast<uint32_t>(destX - 1 - x));
+                    case 180:
+                        return source.At(static_cast<uint32_t>(destX - 1 - x), static_cast<uint32_t>(destY - 1 - y));
+                    case 270:
+                        return source.At(static_cast<uint32_t>(destY - 1 - y), static_cast<uint32_t>(x - destX));
+                    default:
+                        return source.At(static_cast<uint32_t>(x - destX), static_cast<uint32_t>(y - destY));
+                }
+            };
+
+            // the target is walked in strips of rows split into blocks, a block reads one cache line from each
+            // source row it covers. Same format copies rotate straight into the target, others through a strip buffer
+            const size_t sourceBpp = sourceInfo.bytesPerPixel;
+            const size_t targetBpp = targetInfo.bytesPerPixel;
+            const bool direct = bc.mode == BlendMode::NOBLEND && sourceFormat == targetFormat && !source.tiled;
+            PixelConverter::ConvertFunc reverseFunc = PixelConverter::GetReverseFunction(sourceFormat);
+            std::vector<uint8_t> &stripBuffer = context.transformedTextureRenderer.rotateStrip;
+            if (!direct)
+                stripBuffer.resize(ROTATE_STRIP_ROWS * ROTATE_STRIP_COLUMNS * sourceBpp);
+            uint8_t *strip = stripBuffer.data();
+            const ptrdiff_t stripPitch = ROTATE_STRIP_COLUMNS * sourceBpp;
+            const ptrdiff_t sourcePitch = static_cast<ptrdiff_t>(source.pitch);
+            for (int64_t y = startY; y < endY; y += ROTATE_STRIP_ROWS)
+            {
+                const uint32_t rows = static_cast<uint32_t>(std::min<int64_t>(ROTATE_STRIP_ROWS, endY - y));
+                for (int64_t x = startX; x < endX; x += ROTATE_STRIP_COLUMNS)
+                {
+                    const uint32_t columns = static_cast<uint32_t>(std::min<int64_t>(ROTATE_STRIP_COLUMNS, endX - x));
+                    uint8_t *target = targetData + y * targetPitch + x * targetBpp;
+                    uint8_t *out = direct ? target : strip;
+                    const ptrdiff_t outPitch = direct ? static_cast<ptrdiff_t>(targetPitch) : stripPitch;
+
+                    if (source.tiled)
                     {
-                        case 0:
-                            sourceX = x;
-                            sourceY = y;
-                            break;
-                        case 270:
-                            sourceX = height - 1 - y;
-                            sourceY = x;
-                            break;
-                        case 180:
-                            sourceX = width - 1 - x;
-                            sourceY = height - 1 - y;
-                            break;
-                        case 90:
-                            sourceX = y;
-                            sourceY = width - 1 - x;
-                            break;
+                        for (uint32_t row = 0; row < rows; ++row)
+                            for (uint32_t column = 0; column < columns; ++column)
+                                std::memcpy(out + row * outPitch + column * sourceBpp, sourceTexel(x + column, y + row), sourceBpp);
                     }
-
-                    // Check texture bounds
-                    if (sourceX < tstartX || sourceX > tendX || sourceY < tStartY || sourceY > tendY)
-                        continue;
-
-                    const uint8_t *sourcePixel = sourceData + sourceY * sourcePitch + sourceX * sourceInfo.bytesPerPixel;
-                    if (pos == 0)
+                    else if (angle == 180)
                     {
-                        targetPixel = targetData + (startY + y) * targetPitch + (startX + x) * targetInfo.bytesPerPixel;
+                        for (uint32_t row = 0; row < rows; ++row)
+                            reverseFunc(sourceTexel(x + columns - 1, y + row), out + row * outPitch, columns);
+                    }
+                    else if (angle == 90)
+                    {
+                        // target columns walk up the source, target rows along it
+                        RotateBlit::Transpose(sourceTexel(x, y), -sourcePitch, out, outPitch, columns, rows, sourceInfo.bytesPerPixel);
+                    }
+                    else
+                    {
+                        // target rows walk back along the source, written bottom up this is a plain transpose
+                        RotateBlit::Transpose(sourceTexel(x, y + rows - 1), sourcePitch, out + (rows - 1) * outPitch, -outPitch,
+                                              columns, rows, sourceInfo.bytesPerPixel);
                     }
 
-                    std::memcpy(buffer + sourceInfo.bytesPerPixel * pos, sourcePixel, sourceInfo.bytesPerPixel);
-                    pos++;
-
-                    if (pos == maxPos)
+                    if (direct)
+                        continue;
+                    for (uint32_t row = 0; row < rows; ++row)
                     {
                         if (bc.mode == BlendMode::NOBLEND)
                         {
-                            convertFunc(buffer, targetPixel, pos);
+                            convertFunc(strip + row * stripPitch, target + row * targetPitch, columns);
                         }
                         else
                         {
-                            context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(), false, bc);
+                            context.GetBlendFunc()(target + row * targetPitch, strip + row * stripPitch, columns, targetInfo, sourceInfo, context.GetColoring(), false, bc);
                         }
-                        pos = 0;
-                    }
-                }
-
-                // Handle remaining pixels in the row
-                if (pos != 0)
-                {
-                    if (bc.mode == BlendMode::NOBLEND)
-                    {
-                        convertFunc(buffer, targetPixel, pos);
-                    }
-                    else
-                    {
-                        context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(), false, bc);
                     }
-                    pos = 0;
                 }
             }
             return;
@@ -222,20 +567,29 @@ void Tergos2D::TransformedTextureRenderer::DrawTexture(Texture &texture, const f
         if (y > maxY) maxY = y;
     }
 
+    // smoothed edges reach up to a pixel past the corners
+    if (context.IsEdgeAntialiasingEnabled())
+    {
+        minX -= 1.0f;
+        minY -= 1.0f;
+        maxX += 1.0f;
+        maxY += 1.0f;
+    }
+
     // Clamp the bounding box to the target texture's dimensions
-    int16_t startX = std::max(static_cast<int16_t>(std::floor(minX)), static_cast<int16_t>(0));
-    int16_t startY = std::max(static_cast<int16_t>(std::floor(minY)), static_cast<int16_t>(0));
-    int16_t endX = std::min(static_cast<int16_t>(std::ceil(maxX)), static_cast<int16_t>(targetWidth));
-    int16_t endY = std::min(static_cast<int16_t>(std::ceil(maxY)), static_cast<int16_t>(targetHeight));
+    int32_t startX = std::max(ClampCoordinate(std::floor(minX)), static_cast<int32_t>(0));
+    int32_t startY = std::max(ClampCoordinate(std::floor(minY)), static_cast<int32_t>(0));
+    int32_t endX = std::min(ClampCoordinate(std::ceil(maxX)), static_cast<int32_t>(targetWidth));
+    int32_t endY = std::min(ClampCoordinate(std::ceil(maxY)), static_cast<int32_t>(targetHeight));
 
 
     if (context.IsClippingEnabled())
     {
         auto clippingArea = context.GetClippingArea();
-        startX = std::max(startX, static_cast<int16_t>(clippingArea.startX));
-        startY = std::max(startY, static_cast<int16_t>(clippingArea.startY));
-        endX = std::min(endX, static_cast<int16_t>(clippingArea.endX));
-        endY = std::min(endY, static_cast<int16_t>(clippingArea.endY));
+        startX = std::max(startX, static_cast<int32_t>(clippingArea.startX));
+        startY = std::max(startY, static_cast<int32_t>(clippingArea.startY));
+        endX = std::min(endX, static_cast<int32_t>(clippingArea.endX));
+        endY = std::min(endY, static_cast<int32_t>(clippingArea.endY));
     }
 
     // Define the inverse transformation matrix
@@ -260,73 +614,201 @@ void Tergos2D::TransformedTextureRenderer::DrawTexture(Texture &texture, const f
     invMatrix[2][1] = (transformationMatrix[0][1] * transformationMatrix[2][0] - transformationMatrix[0][0] * transformationMatrix[2][1]) * invDet;
     invMatrix[2][2] = (transformationMatrix[0][0] * transformationMatrix[1][1] - transformationMatrix[0][1] * transformationMatrix[1][0]) * invDet;
 
+    if (!noPerspective)
+    {
+        DrawProjective(texture, invMatrix, context, tstartX, tStartY, tendX, tendY, false);
+        return;
+    }
 
-    // Iterate over the bounding box in the target texture
-    const int maxPos = MAX_BUFFER_SIZE;
-    uint8_t buffer[maxPos*4];
-    int pos = 0;
-
-    uint8_t *targetPixel = nullptr;
     PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
     if(!convertFunc) return;
-    for (int16_t y = startY; y < endY; ++y)
+
+    // only the exact span of every row that maps into the source is visited
+    const SourceBounds bounds = {static_cast<float>(tstartX), static_cast<float>(tendX),
+                                 static_cast<float>(tStartY), static_cast<float>(tendY), sourceWidth, sourceHeight};
+    const int maxPos = MAX_BUFFER_SIZE;
+    uint8_t buffer[maxPos*4];
+    const int64_t stepU = ToFixed(invMatrix[0][0]);
+    const int64_t stepV = ToFixed(invMatrix[1][0]);
+    const int64_t maxU = static_cast<int64_t>(sourceWidth - 1) << 32;
+    const int64_t maxV = static_cast<int64_t>(sourceHeight - 1) << 32;
+    // 32 bit texels of linear textures are fetched by the platform sampler
+    const bool vectorFetch = !source.tiled && sourceInfo.bytesPerPixel == 4;
+
+    // draws columns [from, to) of row y
+    auto drawSpan = [&](int32_t y, int32_t from, int32_t to)
     {
-        for (int16_t x = startX; x < endX; ++x)
+        // 32.32 fixed point source position, clamped in case rounding steps past an edge of the span
+        int64_t u = ToFixed(invMatrix[0][0] * from + invMatrix[0][1] * y + invMatrix[0][2]);
+        int64_t v = ToFixed(invMatrix[1][0] * from + invMatrix[1][1] * y + invMatrix[1][2]);
+        uint8_t *targetPixel = targetData + y * targetPitch + from * targetInfo.bytesPerPixel;
+        for (int32_t x = from; x < to; x += maxPos)
         {
-            // Apply the inverse transformation to find the corresponding source pixel
-            float srcX = invMatrix[0][0] * x + invMatrix[0][1] * y + invMatrix[0][2];
-            float srcY = invMatrix[1][0] * x + invMatrix[1][1] * y + invMatrix[1][2];
-
-            // in case we don't want to render the entire texture we need to clip it again
-            if (srcX < tstartX || srcX > tendX || srcY < tStartY || srcY > tendY)
-                continue;
-            // Check if the source pixel is within bounds
-            if (srcX >= 0 && srcX < sourceWidth && srcY >= 0 && srcY < sourceHeight)
+            int count = std::min(maxPos, to - x);
+            // positions are linear, so a chunk whose first and last positions are inside needs no clamping
+            int64_t lastU = u + stepU * (count - 1);
+            int64_t lastV = v + stepV * (count - 1);
+            if (vectorFetch && std::min(u, lastU) >= 0 && std::max(u, lastU) <= maxU &&
+                std::min(v, lastV) >= 0 && std::max(v, lastV) <= maxV)
             {
-                uint16_t intSrcX = static_cast<uint16_t>(srcX);
-                uint16_t intSrcY = static_cast<uint16_t>(srcY);
-                if(pos == 0)
+                AffineSampler::SampleRow32(source.data, source.pitch, u, v, stepU, stepV, buffer, count);
+                u += stepU * count;
+                v += stepV * count;
+            }
+            else
+            {
+                for (int i = 0; i < count; ++i, u += stepU, v += stepV)
                 {
-                    targetPixel = targetData + y * targetPitch + x * targetInfo.bytesPerPixel;
+                    uint32_t intSrcX = static_cast<uint32_t>(std::clamp<int64_t>(u, 0, maxU) >> 32);
+                    uint32_t intSrcY = static_cast<uint32_t>(std::clamp<int64_t>(v, 0, maxV) >> 32);
+                    std::memcpy(buffer + sourceInfo.bytesPerPixel * i, source.At(intSrcX, intSrcY), sourceInfo.bytesPerPixel);
                 }
-                const uint8_t *sourcePixel = sourceData + intSrcY * sourcePitch + intSrcX * sourceInfo.bytesPerPixel;
-                std::memcpy(buffer + sourceInfo.bytesPerPixel*pos, sourcePixel,sourceInfo.bytesPerPixel);
-                pos++;
+            }
 
-                if (pos == maxPos)
-                {
+            if(bc.mode == BlendMode::NOBLEND){
+                convertFunc(buffer, targetPixel, count);
+            }
+            else{
+                context.GetBlendFunc()(targetPixel, buffer, count, targetInfo, sourceInfo, context.GetColoring(),false,bc);
+            }
+            targetPixel += count * targetInfo.bytesPerPixel;
+        }
+    };
 
-                    if(bc.mode == BlendMode::NOBLEND){
-                        convertFunc(buffer, targetPixel, pos);
-                    }
-                    else{
-                        context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(),false,bc);
-                    }
-                    pos = 0;
-                }
+    if (!context.IsEdgeAntialiasingEnabled())
+    {
+        for (int32_t y = startY; y < endY; ++y)
+        {
+            int32_t spanStart, spanEnd;
+            if (RowSpan(invMatrix, bounds, y, startX, endX, spanStart, spanEnd))
+                drawSpan(y, spanStart, spanEnd);
+        }
+        return;
+    }
 
+    // edge pixels are sampled at their clamped position and blended with the coverage as alpha
+    const float minU = static_cast<float>(std::max(tstartX, 0));
+    const float minV = static_cast<float>(std::max(tStartY, 0));
+    const float edgeMaxU = static_cast<float>(std::min<int64_t>(tendX, sourceWidth));
+    const float edgeMaxV = static_cast<float>(std::min<int64_t>(tendY, sourceHeight));
+    if (!(minU < edgeMaxU && minV < edgeMaxV))
+        return;
+    const EdgeCoverage edges(invMatrix, minU, edgeMaxU, minV, edgeMaxV);
+    const PixelFormatInfo &edgeInfo = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
+    PixelConverter::ConvertFunc unpackFunc = PixelConverter::GetConversionFunction(sourceFormat, PixelFormat::ARGB8888);
+    BlendContext edgeContext = bc;
+    edgeContext.mode = BlendMode::BLEND;
+    uint32_t edgePixels[maxPos];
+    auto drawEdge = [&](int32_t y, int32_t from, int32_t to)
+    {
+        uint8_t *targetPixel = targetData + y * targetPitch + from * targetInfo.bytesPerPixel;
+        for (int32_t x = from; x < to; x += maxPos)
+        {
+            int count = std::min(maxPos, to - x);
+            for (int i = 0; i < count; ++i)
+            {
+                float srcX = invMatrix[0][0] * (x + i) + invMatrix[0][1] * y + invMatrix[0][2];
+                float srcY = invMatrix[1][0] * (x + i) + invMatrix[1][1] * y + invMatrix[1][2];
+                uint32_t intSrcX = static_cast<uint32_t>(std::clamp(srcX, minU, edgeMaxU - 1));
+                uint32_t intSrcY = static_cast<uint32_t>(std::clamp(srcY, minV, edgeMaxV - 1));
+                std::memcpy(buffer + sourceInfo.bytesPerPixel * i, source.At(intSrcX, intSrcY), sourceInfo.bytesPerPixel);
             }
+            uint8_t *argb = reinterpret_cast<uint8_t *>(edgePixels);
+            if (unpackFunc)
+                unpackFunc(buffer, argb, count);
+            else
+                for (int i = 0; i < count; ++i)
+                    Color(buffer + sourceInfo.bytesPerPixel * i, sourceFormat).ConvertTo(PixelFormat::ARGB8888, argb + i * 4);
+            edges.ApplyToAlpha(argb, x, y, count);
+            context.GetBlendFunc()(targetPixel, argb, count, targetInfo, edgeInfo, context.GetColoring(), false, edgeContext);
+            targetPixel += count * targetInfo.bytesPerPixel;
         }
-        if(pos != 0)
+    };
+
+    for (int32_t y = startY; y < endY; ++y)
+    {
+        int32_t outerStart, innerStart, innerEnd, outerEnd;
+        if (!edges.RowSpans(y, startX, endX, outerStart, innerStart, innerEnd, outerEnd))
+            continue;
+        drawEdge(y, outerStart, innerStart);
+        drawSpan(y, innerStart, innerEnd);
+        drawEdge(y, innerEnd, outerEnd);
+    }
+}
+
+bool Tergos2D::TransformedTextureRenderer::RowSpan(const float invMatrix[3][3], const SourceBounds &bounds, int32_t y,
+                                                   int32_t startX, int32_t endX, int32_t &spanStart, int32_t &spanEnd)
+{
+    // solve lower <= a * x + b <= upper for both source coordinates
+    double first = startX;
+    double last = endX - 1;
+    auto constrain = [&](double a, double b, double lower, double upper)
+    {
+        if (a == 0)
         {
-            if(bc.mode == BlendMode::NOBLEND){
-                convertFunc(buffer, targetPixel, pos);
-            }
-            else{
-                context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(),false,bc);
-            }
-            pos = 0;
+            if (b < lower || b > upper)
+                last = first - 1;
+            return;
         }
+        double from = (lower - b) / a;
+        double to = (upper - b) / a;
+        if (a < 0)
+            std::swap(from, to);
+        first = std::max(first, std::ceil(from));
+        last = std::min(last, std::floor(to));
+    };
+    constrain(invMatrix[0][0], static_cast<double>(invMatrix[0][1]) * y + invMatrix[0][2],
+              std::max(bounds.minU, 0.0f), std::min(bounds.maxU, static_cast<float>(bounds.width)));
+    constrain(invMatrix[1][0], static_cast<double>(invMatrix[1][1]) * y + invMatrix[1][2],
+              std::max(bounds.minV, 0.0f), std::min(bounds.maxV, static_cast<float>(bounds.height)));
+
+    spanStart = static_cast<int32_t>(std::clamp<double>(first, startX, endX));
+    spanEnd = static_cast<int32_t>(std::clamp<double>(last + 1, spanStart, endX));
+
+    // the per pixel float test decides at the borders, so spans match the unclipped loops exactly
+    auto inside = [&](int32_t x)
+    {
+        float srcX = invMatrix[0][0] * x + invMatrix[0][1] * y + invMatrix[0][2];
+        float srcY = invMatrix[1][0] * x + invMatrix[1][1] * y + invMatrix[1][2];
+        return !(srcX < bounds.minU || srcX > bounds.maxU || srcY < bounds.minV || srcY > bounds.maxV) &&
+               srcX >= 0 && srcX < bounds.width && srcY >= 0 && srcY < bounds.height;
+    };
+    while (spanStart < spanEnd && !inside(spanStart))
+        ++spanStart;
+    while (spanEnd > spanStart && !inside(spanEnd - 1))
+        --spanEnd;
+    if (spanStart == spanEnd)
+    {
+        // rounding may have emptied a span of one or two pixels
+        if (spanStart > startX && inside(spanStart - 1))
+            --spanStart;
+        else if (spanEnd < endX && inside(spanEnd))
+            ++spanEnd;
+        else
+            return false;
     }
+    while (spanStart > startX && inside(spanStart - 1))
+        --spanStart;
+    while (spanEnd < endX && inside(spanEnd))
+        ++spanEnd;
+    return true;
 }
 
 void Tergos2D::TransformedTextureRenderer::DrawTextureSamplingSupp(Texture &texture, const float transformationMatrix[3][3], RenderContext2D &context, int tstartX, int tStartY, int tendX, int tendY)
 {
-    auto targetTexture = context.GetTargetTexture();
+    auto targetTexture = context.GetDrawTarget();
     if (!targetTexture || !texture.GetData())
     {
         return;
     }
+
+    float mipMatrix[3][3];
+    Texture &mip = SelectMip(texture, transformationMatrix, mipMatrix, tstartX, tStartY, tendX, tendY);
+    if (&mip != &texture)
+    {
+        DrawTextureSamplingSupp(mip, mipMatrix, context, tstartX, tStartY, tendX, tendY);
+        return;
+    }
     //revert to normal method when nearest is used
     if(context.GetSamplingMethod() == SamplingMethod::NEAREST){
         DrawTexture(texture,transformationMatrix,context,tstartX,tStartY,tendX,tendY);
@@ -368,17 +850,16 @@ void Tergos2D::TransformedTextureRenderer::DrawTextureSamplingSupp(Texture &text
     // Get source texture information
     PixelFormat sourceFormat = texture.GetFormat();
     PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
-    uint8_t *sourceData = texture.GetData();
-    uint16_t sourceWidth = texture.GetWidth();
-    uint16_t sourceHeight = texture.GetHeight();
-    size_t sourcePitch = texture.GetPitch();
+    PixelAddressing source = texture.GetAddressing();
+    uint32_t sourceWidth = texture.GetWidth();
+    uint32_t sourceHeight = texture.GetHeight();
 
     // Get target texture information
     PixelFormat targetFormat = targetTexture->GetFormat();
     PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
     uint8_t *targetData = targetTexture->GetData();
-    uint16_t targetWidth = targetTexture->GetWidth();
-    uint16_t targetHeight = targetTexture->GetHeight();
+    uint32_t targetWidth = targetTexture->GetWidth();
+    uint32_t targetHeight = targetTexture->GetHeight();
     size_t targetPitch = targetTexture->GetPitch();
 
     // Calculate the bounding box of the transformed source texture
@@ -405,20 +886,29 @@ void Tergos2D::TransformedTextureRenderer::DrawTextureSamplingSupp(Texture &text
         if (y > maxY) maxY = y;
     }
 
+    // smoothed edges reach up to a pixel past the corners
+    if (context.IsEdgeAntialiasingEnabled())
+    {
+        minX -= 1.0f;
+        minY -= 1.0f;
+        maxX += 1.0f;
+        maxY += 1.0f;
+    }
+
     // Clamp the bounding box to the target texture's dimensions
-    int16_t startX = std::max(static_cast<int16_t>(std::floor(minX)), static_cast<int16_t>(0));
-    int16_t startY = std::max(static_cast<int16_t>(std::floor(minY)), static_cast<int16_t>(0));
-    int16_t endX = std::min(static_cast<int16_t>(std::ceil(maxX)), static_cast<int16_t>(targetWidth));
-    int16_t endY = std::min(static_cast<int16_t>(std::ceil(maxY)), static_cast<int16_t>(targetHeight));
+    int32_t startX = std::max(ClampCoordinate(std::floor(minX)), static_cast<int32_t>(0));
+    int32_t startY = std::max(ClampCoordinate(std::floor(minY)), static_cast<int32_t>(0));
+    int32_t endX = std::min(ClampCoordinate(std::ceil(maxX)), static_cast<int32_t>(targetWidth));
+    int32_t endY = std::min(ClampCoordinate(std::ceil(maxY)), static_cast<int32_t>(targetHeight));
 
 
     if (context.IsClippingEnabled())
     {
         auto clippingArea = context.GetClippingArea();
-        startX = std::max(startX, static_cast<int16_t>(clippingArea.startX));
-        startY = std::max(startY, static_cast<int16_t>(clippingArea.startY));
-        endX = std::min(endX, static_cast<int16_t>(clippingArea.endX));
-        endY = std::min(endY, static_cast<int16_t>(clippingArea.endY));
+        startX = std::max(startX, static_cast<int32_t>(clippingArea.startX));
+        startY = std::max(startY, static_cast<int32_t>(clippingArea.startY));
+        endX = std::min(endX, static_cast<int32_t>(clippingArea.endX));
+        endY = std::min(endY, static_cast<int32_t>(clippingArea.endY));
     }
 
     // Define the inverse transformation matrix
@@ -446,94 +936,249 @@ void Tergos2D::TransformedTextureRenderer::DrawTextureSamplingSupp(Texture &text
     BlendContext bc = context.GetBlendContext();
     bc.mode = context.BlendModeToUse(sourceInfo);
 
-    // Iterate over the bounding box in the target texture
-    const int maxPos = MAX_BUFFER_SIZE;
-    uint8_t buffer[maxPos*4];
-    int pos = 0;
-
-    uint8_t *targetPixel = nullptr;
-    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(sourceFormat, targetFormat);
-    if(!convertFunc) return;
-    auto sampMethod = context.GetSamplingMethod();
-    for (int16_t y = startY; y < endY; ++y)
+    if (!noPerspective)
     {
-        for (int16_t x = startX; x < endX; ++x)
-        {
-            // Apply the inverse transformation to find the corresponding source pixel
-            float srcX = invMatrix[0][0] * x + invMatrix[0][1] * y + invMatrix[0][2];
-            float srcY = invMatrix[1][0] * x + invMatrix[1][1] * y + invMatrix[1][2];
+        DrawProjective(texture, invMatrix, context, tstartX, tStartY, tendX, tendY, true);
+        return;
+    }
 
+    const PixelFormatInfo &filteredInfo = PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888);
+    PixelConverter::ConvertFunc packFunc = PixelConverter::GetConversionFunction(PixelFormat::ARGB8888, targetFormat);
+    if (bc.mode == BlendMode::NOBLEND && !packFunc)
+        return;
 
-            // in case we don't want to render the entire texture we need to clip it again
-            if (srcX < tstartX || srcX > tendX || srcY < tStartY || srcY > tendY)
-                continue;
+    // positions and neighbours are clamped to the drawn part of the source, edges never read past it
+    const int64_t lowX = std::max(tstartX, 0);
+    const int64_t lowY = std::max(tStartY, 0);
+    const int64_t highX = std::min<int64_t>(sourceWidth, tendX) - 1;
+    const int64_t highY = std::min<int64_t>(sourceHeight, tendY) - 1;
+    if (highX < lowX || highY < lowY)
+        return;
+    const FilterSource filterSource = {source, sourceFormat, PixelConverter::GetConversionFunction(sourceFormat, PixelFormat::ARGB8888),
+                                       lowX << 32, ((highX + 1) << 32) - 1, lowY << 32, ((highY + 1) << 32) - 1};
 
+    const SourceBounds bounds = {static_cast<float>(tstartX), static_cast<float>(tendX),
+                                 static_cast<float>(tStartY), static_cast<float>(tendY), sourceWidth, sourceHeight};
+    const int maxPos = MAX_BUFFER_SIZE;
+    int64_t us[maxPos];
+    int64_t vs[maxPos];
+    uint32_t filtered[maxPos];
+    const int64_t stepU = ToFixed(invMatrix[0][0]);
+    const int64_t stepV = ToFixed(invMatrix[1][0]);
+    BlendContext edgeContext = bc;
+    edgeContext.mode = BlendMode::BLEND;
+
+    // draws columns [from, to) of row y, edge spans carry their coverage in the alpha of the filtered texels
+    auto drawSpan = [&](int32_t y, int32_t from, int32_t to, const EdgeCoverage *edges)
+    {
+        int64_t u = ToFixed(invMatrix[0][0] * from + invMatrix[0][1] * y + invMatrix[0][2]);
+        int64_t v = ToFixed(invMatrix[1][0] * from + invMatrix[1][1] * y + invMatrix[1][2]);
+        uint8_t *targetPixel = targetData + y * targetPitch + from * targetInfo.bytesPerPixel;
+        for (int32_t x = from; x < to; x += maxPos)
+        {
+            int count = std::min(maxPos, to - x);
+            for (int i = 0; i < count; ++i, u += stepU, v += stepV)
+            {
+                us[i] = u;
+                vs[i] = v;
+            }
+            FilterTexels(filterSource, us, vs, count, filtered);
 
-            // Check if the source pixel is within bounds
-            if (srcX >= 0 && srcX < sourceWidth && srcY >= 0 && srcY < sourceHeight)
+            if (edges)
             {
-                uint16_t intSrcX = static_cast<uint16_t>(srcX);
-                uint16_t intSrcY = static_cast<uint16_t>(srcY);
-                if(pos == 0)
-                {
-                    targetPixel = targetData + y * targetPitch + x * targetInfo.bytesPerPixel;
-                }
-                const uint8_t *sourcePixel = sourceData + intSrcY * sourcePitch + intSrcX * sourceInfo.bytesPerPixel;
+                edges->ApplyToAlpha(reinterpret_cast<uint8_t *>(filtered), x, y, count);
+                context.GetBlendFunc()(targetPixel, reinterpret_cast<uint8_t *>(filtered), count, targetInfo, filteredInfo, context.GetColoring(), false, edgeContext);
+            }
+            else if(bc.mode == BlendMode::NOBLEND){
+                packFunc(reinterpret_cast<uint8_t *>(filtered), targetPixel, count);
+            }
+            else{
+                context.GetBlendFunc()(targetPixel, reinterpret_cast<uint8_t *>(filtered), count, targetInfo, filteredInfo, context.GetColoring(),false,bc);
+            }
+            targetPixel += count * targetInfo.bytesPerPixel;
+        }
+    };
 
-                switch (sampMethod)
-                {
-                case SamplingMethod::LINEAR:
-                    {
-                        // Compute the weights for linear interpolation
-                        float fracX = srcX - intSrcX;
-                        float fracY = srcY - intSrcY;
+    if (!context.IsEdgeAntialiasingEnabled())
+    {
+        for (int32_t y = startY; y < endY; ++y)
+        {
+            int32_t spanStart, spanEnd;
+            if (RowSpan(invMatrix, bounds, y, startX, endX, spanStart, spanEnd))
+                drawSpan(y, spanStart, spanEnd, nullptr);
+        }
+        return;
+    }
 
-                        uint8_t *srcPixel00 = sourceData + intSrcY * sourcePitch + intSrcX * sourceInfo.bytesPerPixel;
-                        uint8_t *srcPixel01 = sourceData + intSrcY * sourcePitch + (intSrcX + 1) * sourceInfo.bytesPerPixel;
-                        uint8_t *srcPixel10 = sourceData + (intSrcY + 1) * sourcePitch + intSrcX * sourceInfo.bytesPerPixel;
-                        uint8_t *srcPixel11 = sourceData + (intSrcY + 1) * sourcePitch + (intSrcX + 1) * sourceInfo.bytesPerPixel;
+    const EdgeCoverage edges(invMatrix, static_cast<float>(lowX), static_cast<float>(highX + 1),
+                             static_cast<float>(lowY), static_cast<float>(highY + 1));
+    for (int32_t y = startY; y < endY; ++y)
+    {
+        int32_t outerStart, innerStart, innerEnd, outerEnd;
+        if (!edges.RowSpans(y, startX, endX, outerStart, innerStart, innerEnd, outerEnd))
+            continue;
+        drawSpan(y, outerStart, innerStart, &edges);
+        drawSpan(y, innerStart, innerEnd, nullptr);
+        drawSpan(y, innerEnd, outerEnd, &edges);
+    }
+}
 
-                        // Linear interpolation
-                        for (int c = 0; c < sourceInfo.bytesPerPixel; ++c)
-                        {
-                            float value = (1 - fracX) * (1 - fracY) * srcPixel00[c] +
-                                            fracX * (1 - fracY) * srcPixel01[c] +
-                                            (1 - fracX) * fracY * srcPixel10[c] +
-                                            fracX * fracY * srcPixel11[c];
+void Tergos2D::TransformedTextureRenderer::DrawProjective(Texture &texture, const float invMatrix[3][3], RenderContext2D &context,
+                                                          int tstartX, int tStartY, int tendX, int tendY, bool filtered)
+{
+    auto targetTexture = context.GetDrawTarget();
+    PixelFormat sourceFormat = texture.GetFormat();
+    const PixelFormatInfo &sourceInfo = PixelFormatRegistry::GetInfo(sourceFormat);
+    PixelAddressing source = texture.GetAddressing();
+    PixelFormat targetFormat = targetTexture->GetFormat();
+    const PixelFormatInfo &targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+    uint8_t *targetData = targetTexture->GetData();
+    size_t targetPitch = targetTexture->GetPitch();
 
-                            buffer[pos * sourceInfo.bytesPerPixel + c] = static_cast<uint8_t>(value);
-                        }
-                        break;
-                    }
-                default:
-                        std::memcpy(buffer + sourceInfo.bytesPerPixel*pos, sourcePixel,sourceInfo.bytesPerPixel);
-                    break;
-                }
+    BlendContext bc = context.GetBlendContext();
+    bc.mode = context.BlendModeToUse(sourceInfo);
+    // nearest texels are drawn in the source format, filtered ones as ARGB8888
+    const PixelFormatInfo &drawnInfo = filtered ? PixelFormatRegistry::GetInfo(PixelFormat::ARGB8888) : sourceInfo;
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(drawnInfo.format, targetFormat);
+    if (!convertFunc && (!filtered || bc.mode == BlendMode::NOBLEND))
+        return;
 
-                pos++;
+    const int64_t lowX = std::max(tstartX, 0);
+    const int64_t lowY = std::max(tStartY, 0);
+    const int64_t highX = std::min<int64_t>(texture.GetWidth(), tendX) - 1;
+    const int64_t highY = std::min<int64_t>(texture.GetHeight(), tendY) - 1;
+    if (highX < lowX || highY < lowY)
+        return;
+    const FilterSource filterSource = {source, sourceFormat, PixelConverter::GetConversionFunction(sourceFormat, PixelFormat::ARGB8888),
+                                       lowX << 32, ((highX + 1) << 32) - 1, lowY << 32, ((highY + 1) << 32) - 1};
 
-                if (pos == maxPos)
-                {
-                    if(bc.mode == BlendMode::NOBLEND){
-                        convertFunc(buffer, targetPixel, pos);
-                    }
-                    else{
-                        context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(),false,bc);
-                    }
-                    pos = 0;
-                }
+    int32_t startX = 0;
+    int32_t startY = 0;
+    int32_t endX = static_cast<int32_t>(targetTexture->GetWidth());
+    int32_t endY = static_cast<int32_t>(targetTexture->GetHeight());
+    if (context.IsClippingEnabled())
+    {
+        auto clippingArea = context.GetClippingArea();
+        startX = std::max(startX, static_cast<int32_t>(clippingArea.startX));
+        startY = std::max(startY, static_cast<int32_t>(clippingArea.startY));
+        endX = std::min(endX, static_cast<int32_t>(clippingArea.endX));
+        endY = std::min(endY, static_cast<int32_t>(clippingArea.endY));
+    }
 
+    const int maxPos = MAX_BUFFER_SIZE;
+    int64_t us[maxPos];
+    int64_t vs[maxPos];
+    uint32_t texels[maxPos];
+    uint8_t *buffer = reinterpret_cast<uint8_t *>(texels);
+    const double lowU = static_cast<double>(lowX), highU = static_cast<double>(highX + 1);
+    const double lowV = static_cast<double>(lowY), highV = static_cast<double>(highY + 1);
+    for (int32_t y = startY; y < endY; ++y)
+    {
+        // u * w, v * w and w are linear along the row
+        const double au = invMatrix[0][0], bu = static_cast<double>(invMatrix[0][1]) * y + invMatrix[0][2];
+        const double av = invMatrix[1][0], bv = static_cast<double>(invMatrix[1][1]) * y + invMatrix[1][2];
+        const double aw = invMatrix[2][0], bw = static_cast<double>(invMatrix[2][1]) * y + invMatrix[2][2];
+
+        // in front of the viewer (w > 0) the source rectangle constraints stay linear once multiplied by w
+        double first = startX;
+        double last = endX - 1;
+        auto constrain = [&](double a, double b)
+        {
+            // a * x + b >= 0
+            if (a == 0)
+            {
+                if (b < 0)
+                    last = first - 1;
+                return;
             }
-        }
-        if(pos != 0)
+            if (a > 0)
+                first = std::max(first, std::ceil(-b / a));
+            else
+                last = std::min(last, std::floor(-b / a));
+        };
+        constrain(aw, bw);
+        constrain(au - lowU * aw, bu - lowU * bw);
+        constrain(highU * aw - au, highU * bw - bu);
+        constrain(av - lowV * aw, bv - lowV * bw);
+        constrain(highV * aw - av, highV * bw - bv);
+        if (first > last)
+            continue;
+        int32_t spanStart = static_cast<int32_t>(first);
+        int32_t spanEnd = static_cast<int32_t>(last) + 1;
+        while (spanStart < spanEnd && aw * spanStart + bw <= 0)
+            ++spanStart;
+        while (spanEnd > spanStart && aw * (spanEnd - 1) + bw <= 0)
+            --spanEnd;
+        if (spanStart == spanEnd)
+            continue;
+
+        auto project = [&](int32_t x, int64_t &u, int64_t &v)
         {
-            if(bc.mode == BlendMode::NOBLEND){
-                convertFunc(buffer, targetPixel, pos);
+            double reciprocal = 1.0 / (aw * x + bw);
+            u = ToFixedClamped((au * x + bu) * reciprocal);
+            v = ToFixedClamped((av * x + bv) * reciprocal);
+        };
+
+        // linear steps stray from the true positions by about length^2 / 8 * |u''|, with u'' = -2 * aw * u' / w.
+        // Segments are PERSPECTIVE_SPAN pixels long and halved on rows where that exceeds an eighth of a texel
+        auto bend = [&](int32_t x)
+        {
+            double w = aw * x + bw;
+            double du = (au - aw * (au * x + bu) / w) / w;
+            double dv = (av - aw * (av * x + bv) / w) / w;
+            return 2.0 * std::abs(aw) * std::max(std::abs(du), std::abs(dv)) / w;
+        };
+        const double rowBend = std::max(bend(spanStart), bend(spanEnd - 1));
+        int segment = PERSPECTIVE_SPAN;
+        while (segment > 1 && segment * segment * rowBend > 1.0)
+            segment >>= 1;
+
+        // exact positions at the segment ends, linear steps in between
+        int64_t u0, v0;
+        project(spanStart, u0, v0);
+        uint8_t *targetPixel = targetData + y * targetPitch + spanStart * targetInfo.bytesPerPixel;
+        for (int32_t x = spanStart; x < spanEnd; x += maxPos)
+        {
+            int count = std::min(maxPos, spanEnd - x);
+            for (int i = 0, n = 0; i < count; i += n)
+            {
+                n = std::min(segment, count - i);
+                // the last segment of the span ends on its last pixel, the others on the first pixel of the next
+                int32_t segmentEnd = x + i + n;
+                int steps = segmentEnd == spanEnd ? n - 1 : n;
+                int64_t u1 = u0, v1 = v0;
+                if (steps > 0)
+                    project(x + i + steps, u1, v1);
+                int64_t stepU = steps > 0 ? (u1 - u0) / steps : 0;
+                int64_t stepV = steps > 0 ? (v1 - v0) / steps : 0;
+                for (int k = 0; k < n; ++k)
+                {
+                    us[i + k] = u0 + stepU * k;
+                    vs[i + k] = v0 + stepV * k;
+                }
+                u0 = u1;
+                v0 = v1;
             }
-            else{
-                context.GetBlendFunc()(targetPixel, buffer, pos, targetInfo, sourceInfo, context.GetColoring(),false,bc);
+
+            if (filtered)
+            {
+                FilterTexels(filterSource, us, vs, count, texels);
+            }
+            else
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    uint32_t intSrcX = static_cast<uint32_t>(std::clamp(us[i], filterSource.minU, filterSource.maxU) >> 32);
+                    uint32_t intSrcY = static_cast<uint32_t>(std::clamp(vs[i], filterSource.minV, filterSource.maxV) >> 32);
+                    CopyTexel(buffer + i * sourceInfo.bytesPerPixel, source.At(intSrcX, intSrcY), sourceInfo.bytesPerPixel);
+                }
             }
-            pos = 0;
+
+            if (bc.mode == BlendMode::NOBLEND)
+                convertFunc(buffer, targetPixel, count);
+            else
+                context.GetBlendFunc()(targetPixel, buffer, count, targetInfo, drawnInfo, context.GetColoring(), false, bc);
+            targetPixel += count * targetInfo.bytesPerPixel;
         }
     }
 }
@@ -4,8 +4,13 @@
 #include "../RendererBase.h"
 #include "../../data/Color.h"
 #include "../../data/Texture.h"
+#include "../../data/StreamedTexture.h"
 #include <functional>
+#include <vector>
 #define MAX_BUFFER_SIZE 64
+#define ROTATE_STRIP_ROWS 16
+#define ROTATE_STRIP_COLUMNS 256
+#define PERSPECTIVE_SPAN 16
 namespace Tergos2D
 {
 
@@ -18,7 +23,10 @@ namespace Tergos2D
         TransformedTextureRenderer(RenderContext2D &context);
         ~TransformedTextureRenderer() = default;
 
-        /// @brief draw a texture transformed
+        /// @brief draw a texture transformed. With a scaling cache set on the context, whole textures under an
+        /// axis aligned power of two upscale at a whole pixel position are drawn through the ScaleTextureRenderer
+        /// and its cache, if sampling is nearest, edges are not smoothed and the draw function is not replaced.
+        /// Those draws come out the same either way, other draws never take the cache
         /// @param texture
         /// @param transformationMatrix
         /// @param startX
@@ -31,6 +39,12 @@ namespace Tergos2D
             int endX = 0,
             int endY = 0);
 
+        /// @brief draw a streamed texture transformed with nearest sampling. Only tiles that land in the
+        /// visible area are loaded, they are drawn one after another so a tile is never evicted while in use
+        /// @param texture
+        /// @param transformationMatrix
+        void DrawTexture(StreamedTexture &texture, const float transformationMatrix[3][3]);
+
         /// @brief generic implementation without sampling support
         /// @param texture
         /// @param transformationMatrix
@@ -38,7 +52,8 @@ namespace Tergos2D
         static void DrawTexture(Texture &texture,  const float transformationMatrix[3][3], RenderContext2D& context, int startX, int StartY, int endX, int endY);
 
 
-        /// @brief  Implementation with Sampling Support supports any BytePixel format (RGBA32,RGB24,Grayscale8, etc ..) not formats like rgb565
+        /// @brief  Implementation with bilinear sampling for every pixel format. Texels are unpacked to ARGB8888 and
+        /// interpolated with 8 bit fixed point weights, neighbours are clamped to the edges of the drawn source area
         /// @param texture
         /// @param transformationMatrix
         /// @param context
@@ -52,10 +67,36 @@ namespace Tergos2D
         /// @param drawTexture
         void SetDrawTexture(DrawTexturePointer drawTexture);
     private:
+        /// @brief Source rectangle a target pixel has to map into to be drawn, min and max inclusive,
+        /// width and height exclusive like the per pixel tests of the draw loops
+        struct SourceBounds
+        {
+            float minU, maxU, minV, maxV;
+            uint32_t width, height;
+        };
+
+        /// @brief Exact columns [spanStart, spanEnd) of target row y, within [startX, endX), whose inverse mapped
+        /// position lies in bounds. The span is solved analytically and its ends are checked with the same float math
+        /// as the per pixel tests. Returns false if no pixel of the row is drawn
+        static bool RowSpan(const float invMatrix[3][3], const SourceBounds &bounds, int32_t y,
+            int32_t startX, int32_t endX, int32_t &spanStart, int32_t &spanEnd);
+
+        /// @brief Draws a matrix with a perspective row. Rows are clipped to where w > 0 and the source rectangle is hit,
+        /// along them u/w, v/w and 1/w are divided out every PERSPECTIVE_SPAN pixels (fewer on strongly bent rows)
+        /// and stepped linearly in between
+        static void DrawProjective(Texture &texture, const float invMatrix[3][3], RenderContext2D &context,
+                                   int startX, int startY, int endX, int endY, bool filtered);
+
+        /// @brief Picks the mip level for a minifying affine matrix (by its determinant) and rescales
+        /// the matrix and the source bounds to that level. Returns texture itself if level 0 is used
+        static Texture &SelectMip(Texture &texture, const float transformationMatrix[3][3], float mipMatrix[3][3],
+            int &startX, int &startY, int &endX, int &endY);
 
         	DrawTexturePointer m_drawTexture = DrawTexture;
+        // strip of right angle rotations that convert or blend, kept off the stack and reused between draws
+        std::vector<uint8_t> rotateStrip;
     };
 
 } // namespace Tergos2D
 
-#endif //
\ No newline at end of file
+#endif //
\ No newline at end of file
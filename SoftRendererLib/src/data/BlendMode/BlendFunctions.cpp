@@ -25,6 +25,18 @@ void BlendFunctions::BlendRow(uint8_t *dstRow,
         return;
     }
 
+    BlendRowGeneric(dstRow, srcRow, rowLength, targetInfo, sourceInfo, coloring, useSolidColor, context);
+}
+
+void BlendFunctions::BlendRowGeneric(uint8_t *dstRow,
+                                     const uint8_t *srcRow,
+                                     size_t rowLength,
+                                     const PixelFormatInfo &targetInfo,
+                                     const PixelFormatInfo &sourceInfo,
+                                     Coloring coloring,
+                                     bool useSolidColor,
+                                     BlendContext& context)
+{
     // Get conversion functions once
     PixelConverter::ConvertFunc convertToARGB8888 = nullptr;
     PixelConverter::ConvertFunc convertToARGB8888Target = nullptr;
@@ -42,7 +54,8 @@ void BlendFunctions::BlendRow(uint8_t *dstRow,
 
     for (size_t i = 0; i < rowLength; ++i)
     {
-        const uint8_t *srcPixel = srcRow + i * sourceInfo.bytesPerPixel;
+        // a solid color repeats the first source pixel
+        const uint8_t *srcPixel = useSolidColor ? srcRow : srcRow + i * sourceInfo.bytesPerPixel;
         uint8_t *dstPixel = dstRow + i * targetInfo.bytesPerPixel;
 
         // Convert source to ARGB8888
@@ -37,6 +37,11 @@ namespace Tergos2D
                 if (useSolidColor)
                     return BlendSolidRowRGB24;
                 return BlendRGB24;
+            case PixelFormat::XRGB8888:
+            case PixelFormat::BGRX8888:
+                if (useSolidColor)
+                    return BlendSolidRowXRGB32;
+                return BlendXRGB32;
             default:
                 return nullptr;
             }
@@ -52,6 +57,49 @@ namespace Tergos2D
                              bool useSolidColor,
                              BlendContext& context);
 
+        // true if blending a fully opaque source pixel yields the source pixel,
+        // callers may then copy opaque spans instead of blending them
+        static inline bool OpaqueSourceIsCopy(const BlendContext &context, const Coloring &coloring)
+        {
+            if (context.mode == BlendMode::NOBLEND)
+                return true;
+            if (context.mode != BlendMode::BLEND || coloring.colorEnabled)
+                return false;
+            return IsSourceOver(context);
+        }
+
+        // true for the default factors, source over destination weighted by source alpha
+        static inline bool IsSourceOver(const BlendContext &context)
+        {
+            bool colorIsSource = context.colorBlendFactorSrc == BlendFactor::SourceAlpha &&
+                                 context.colorBlendFactorDst == BlendFactor::InverseSourceAlpha &&
+                                 context.colorBlendOperation == BlendOperation::Add;
+            bool alphaIsSource = context.alphaBlendOperation == BlendOperation::Add &&
+                                 ((context.alphaBlendFactorSrc == BlendFactor::One && context.alphaBlendFactorDst == BlendFactor::Zero) ||
+                                  (context.alphaBlendFactorSrc == BlendFactor::SourceAlpha && context.alphaBlendFactorDst == BlendFactor::InverseSourceAlpha));
+            return colorIsSource && alphaIsSource;
+        }
+
+        // interpolates two 32 bit pixels channel wise, weight (0-256) is the share of b.
+        // even and odd bytes are processed as two 16 bit lanes each, so the channel order does not matter
+        static inline uint32_t LerpLanes(uint32_t a, uint32_t b, uint32_t weight)
+        {
+            uint32_t inverse = 256 - weight;
+            uint32_t even = (((a & 0x00FF00FFu) * inverse + (b & 0x00FF00FFu) * weight + 0x00800080u) >> 8) & 0x00FF00FFu;
+            uint32_t odd = (((a >> 8) & 0x00FF00FFu) * inverse + ((b >> 8) & 0x00FF00FFu) * weight + 0x00800080u) & 0xFF00FF00u;
+            return even | odd;
+        }
+
+        // per pixel fallback over ARGB8888, supports every factor and operation
+        static void BlendRowGeneric(uint8_t *dstRow,
+                                    const uint8_t *srcRow,
+                                    size_t rowLength,
+                                    const PixelFormatInfo &targetInfo,
+                                    const PixelFormatInfo &sourceInfo,
+                                    Coloring coloring,
+                                    bool useSolidColor,
+                                    BlendContext& context);
+
         static void BlendRGB24(uint8_t *dstRow,
                                const uint8_t *srcRow,
                                size_t rowLength,
@@ -116,6 +164,26 @@ namespace Tergos2D
                                        Coloring coloring,
                                        bool useSolidColor,
                                        BlendContext& context);
+
+        // XRGB8888 and BGRX8888 targets, whole 32 bit pixels per step.
+        // Only SOURCEALPHA, INVERSESOURCEALPHA, ADD is vectorized, other contexts use BlendRowGeneric
+        static void BlendXRGB32(uint8_t *dstRow,
+                                const uint8_t *srcRow,
+                                size_t rowLength,
+                                const PixelFormatInfo &targetInfo,
+                                const PixelFormatInfo &sourceInfo,
+                                Coloring coloring,
+                                bool useSolidColor,
+                                BlendContext& context);
+
+        static void BlendSolidRowXRGB32(uint8_t *dstRow,
+                                        const uint8_t *srcRow,
+                                        size_t rowLength,
+                                        const PixelFormatInfo &targetInfo,
+                                        const PixelFormatInfo &sourceInfo,
+                                        Coloring coloring,
+                                        bool useSolidColor,
+                                        BlendContext& context);
     };
 } // namespace Tergos2D
 
@@ -1270,4 +1270,279 @@ void BlendFunctions::BlendRGBA32ToRGB24(uint8_t * dstRow,
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+#define XRGB32_CHUNK 256
+
+namespace
+{
+    inline uint32_t BlendWord(uint32_t src, uint32_t dst, uint32_t alpha)
+    {
+        uint32_t invAlpha = 255 - alpha;
+        uint32_t rb = (((src & 0x00FF00FFu) * alpha + (dst & 0x00FF00FFu) * invAlpha) >> 8) & 0x00FF00FFu;
+        uint32_t ag = (((src >> 8) & 0x00FF00FFu) * alpha + ((dst >> 8) & 0x00FF00FFu) * invAlpha) & 0xFF00FF00u;
+        return rb | ag;
+    }
+
+    inline uint32_t TintWord(uint32_t src, uint32_t tint)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            result |= ((((src >> shift) & 0xFF) * ((tint >> shift) & 0xFF)) >> 8) << shift;
+        }
+        return result;
+    }
+
+    inline bool IsSimpleAlphaBlend(const BlendContext &context)
+    {
+        return context.colorBlendFactorSrc == BlendFactor::SourceAlpha &&
+               context.colorBlendFactorDst == BlendFactor::InverseSourceAlpha &&
+               context.colorBlendOperation == BlendOperation::Add;
+    }
+
+    // (a * b) >> 8 for 16 lanes
+    inline uint8x16_t MulShift8(uint8x16_t a, uint8x16_t b)
+    {
+        uint16x8_t lo = vmull_u8(vget_low_u8(a), vget_low_u8(b));
+        uint16x8_t hi = vmull_u8(vget_high_u8(a), vget_high_u8(b));
+        return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+    }
+
+    // (src * a + dst * ia) >> 8 for 16 lanes
+    inline uint8x16_t BlendPlane(uint8x16_t src, uint8x16_t dst, uint8x16_t alpha, uint8x16_t invAlpha)
+    {
+        uint16x8_t lo = vmull_u8(vget_low_u8(src), vget_low_u8(alpha));
+        lo = vmlal_u8(lo, vget_low_u8(dst), vget_low_u8(invAlpha));
+        uint16x8_t hi = vmull_u8(vget_high_u8(src), vget_high_u8(alpha));
+        hi = vmlal_u8(hi, vget_high_u8(dst), vget_high_u8(invAlpha));
+        return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+    }
+
+    // Blends 16 ARGB8888 source pixels (planes A, R, G, B) into a 32 bit target.
+    // XRGB8888 planes are X, R, G, B, BGRX8888 planes are B, G, R, X
+    template <bool bgrx>
+    inline void BlendBlock16(uint8_t *dst, uint8x16x4_t src, uint8x16_t alpha)
+    {
+        uint8x16x4_t target = vld4q_u8(dst);
+        uint8x16_t invAlpha = vmvnq_u8(alpha);
+        uint8x16_t opaque = vceqq_u8(alpha, vdupq_n_u8(255));
+        uint8x16_t transparent = vceqq_u8(alpha, vdupq_n_u8(0));
+
+        for (int c = 1; c < 4; ++c)
+        {
+            int plane = bgrx ? 3 - c : c;
+            uint8x16_t blended = BlendPlane(src.val[c], target.val[plane], alpha, invAlpha);
+            blended = vbslq_u8(opaque, src.val[c], blended);
+            target.val[plane] = vbslq_u8(transparent, target.val[plane], blended);
+        }
+        target.val[bgrx ? 3 : 0] = vdupq_n_u8(255);
+        vst4q_u8(dst, target);
+    }
+
+    template <bool bgrx>
+    void BlendXRGB32Neon(uint8_t *dstRow,
+                         const uint8_t *srcRow,
+                         size_t rowLength,
+                         const PixelFormatInfo &sourceInfo,
+                         PixelConverter::ConvertFunc convertToARGB8888,
+                         const Coloring &coloring,
+                         const BlendContext &context)
+    {
+        const uint32_t alphaShift = bgrx ? 24 : 0;
+        const uint32_t paddingMask = 0xFFu << alphaShift;
+        const bool graySource = sourceInfo.format == PixelFormat::GRAYSCALE8;
+        const bool coloringOnly = context.mode == BlendMode::COLORINGONLY;
+
+        const uint8_t colorFactor = coloring.colorEnabled ? coloring.color.data[0] : 0;
+        uint32_t tint;
+        std::memcpy(&tint, coloring.color.data, 4);
+        if (bgrx)
+            tint = __builtin_bswap32(tint);
+
+        alignas(16) uint8_t srcARGB[XRGB32_CHUNK * 4];
+
+        for (size_t offset = 0; offset < rowLength; offset += XRGB32_CHUNK)
+        {
+            size_t count = std::min(rowLength - offset, static_cast<size_t>(XRGB32_CHUNK));
+            const uint8_t *src = srcRow + offset * sourceInfo.bytesPerPixel;
+            uint8_t *dst = dstRow + offset * 4;
+
+            convertToARGB8888(src, srcARGB, count);
+
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                uint8x16x4_t color = vld4q_u8(srcARGB + i * 4);
+                uint8x16_t alpha;
+                if (graySource)
+                {
+                    uint8x16_t gray = vld1q_u8(src + i);
+                    alpha = vtstq_u8(gray, gray);
+                }
+                else if (coloringOnly)
+                {
+                    alpha = vdupq_n_u8(255);
+                }
+                else
+                {
+                    alpha = color.val[0];
+                }
+
+                if (colorFactor != 0)
+                {
+                    color.val[1] = MulShift8(color.val[1], vdupq_n_u8(coloring.color.data[1]));
+                    color.val[2] = MulShift8(color.val[2], vdupq_n_u8(coloring.color.data[2]));
+                    color.val[3] = MulShift8(color.val[3], vdupq_n_u8(coloring.color.data[3]));
+                    alpha = MulShift8(alpha, vdupq_n_u8(colorFactor));
+                }
+
+                BlendBlock16<bgrx>(dst + i * 4, color, alpha);
+            }
+
+            // Handle remaining pixels, rows of sub-textures and atlases need not be word aligned
+            for (; i < count; ++i)
+            {
+                uint32_t color;
+                std::memcpy(&color, srcARGB + i * 4, 4);
+                if (bgrx)
+                    color = __builtin_bswap32(color);
+
+                uint32_t alpha;
+                if (graySource)
+                    alpha = src[i] == 0 ? 0 : 255;
+                else if (coloringOnly)
+                    alpha = 255;
+                else
+                    alpha = (color >> alphaShift) & 0xFF;
+
+                if (colorFactor != 0)
+                {
+                    color = TintWord(color, tint);
+                    alpha = (alpha * colorFactor) >> 8;
+                }
+
+                if (alpha == 0)
+                    continue;
+
+                uint32_t word = color | paddingMask;
+                if (alpha != 255)
+                {
+                    std::memcpy(&word, dst + i * 4, 4);
+                    word = BlendWord(color, word, alpha) | paddingMask;
+                }
+                std::memcpy(dst + i * 4, &word, 4);
+            }
+        }
+    }
+}
+
+void BlendFunctions::BlendXRGB32(uint8_t *dstRow,
+                                 const uint8_t *srcRow,
+                                 size_t rowLength,
+                                 const PixelFormatInfo &targetInfo,
+                                 const PixelFormatInfo &sourceInfo,
+                                 Coloring coloring,
+                                 bool useSolidColor,
+                                 BlendContext& context)
+{
+    if (!IsSimpleAlphaBlend(context))
+    {
+        BlendRowGeneric(dstRow, srcRow, rowLength, targetInfo, sourceInfo, coloring, useSolidColor, context);
+        return;
+    }
+
+    PixelConverter::ConvertFunc convertToARGB8888 = PixelConverter::GetConversionFunction(sourceInfo.format, PixelFormat::ARGB8888);
+    if (!convertToARGB8888)
+        return;
+
+    if (targetInfo.format == PixelFormat::BGRX8888)
+        BlendXRGB32Neon<true>(dstRow, srcRow, rowLength, sourceInfo, convertToARGB8888, coloring, context);
+    else
+        BlendXRGB32Neon<false>(dstRow, srcRow, rowLength, sourceInfo, convertToARGB8888, coloring, context);
+}
+
+void BlendFunctions::BlendSolidRowXRGB32(uint8_t *dstRow,
+                                         const uint8_t *srcRow,
+                                         size_t rowLength,
+                                         const PixelFormatInfo &targetInfo,
+                                         const PixelFormatInfo &sourceInfo,
+                                         Coloring coloring,
+                                         bool useSolidColor,
+                                         BlendContext& context)
+{
+    if (!IsSimpleAlphaBlend(context))
+    {
+        BlendRowGeneric(dstRow, srcRow, rowLength, targetInfo, sourceInfo, coloring, useSolidColor, context);
+        return;
+    }
+
+    PixelConverter::ConvertFunc convertToARGB8888 = PixelConverter::GetConversionFunction(sourceInfo.format, PixelFormat::ARGB8888);
+    if (!convertToARGB8888)
+        return;
+
+    const bool swapToBGRX = targetInfo.format == PixelFormat::BGRX8888;
+    const uint32_t alphaShift = swapToBGRX ? 24 : 0;
+    const uint32_t paddingMask = 0xFFu << alphaShift;
+
+    uint32_t color;
+    convertToARGB8888(srcRow, reinterpret_cast<uint8_t *>(&color), 1);
+    if (swapToBGRX)
+        color = __builtin_bswap32(color);
+
+    uint32_t alpha = context.mode == BlendMode::COLORINGONLY ? 255 : (color >> alphaShift) & 0xFF;
+
+    if (coloring.colorEnabled && coloring.color.data[0] != 0)
+    {
+        uint32_t tint;
+        std::memcpy(&tint, coloring.color.data, 4);
+        if (swapToBGRX)
+            tint = __builtin_bswap32(tint);
+        color = TintWord(color, tint);
+        alpha = (alpha * coloring.color.data[0]) >> 8;
+    }
+
+    if (alpha == 0)
+        return;
+
+    color |= paddingMask;
+    size_t i = 0;
+
+    // rows need not be word aligned, words go through memcpy and vectors through byte loads and stores
+    if (alpha == 255)
+    {
+        uint8x16_t fill = vreinterpretq_u8_u32(vdupq_n_u32(color));
+        for (; i + 4 <= rowLength; i += 4)
+        {
+            vst1q_u8(dstRow + i * 4, fill);
+        }
+        for (; i < rowLength; ++i)
+        {
+            std::memcpy(dstRow + i * 4, &color, 4);
+        }
+        return;
+    }
+
+    // source contribution is the same for every pixel, (src * a) is precomputed per byte
+    uint8x16_t srcBytes = vreinterpretq_u8_u32(vdupq_n_u32(color));
+    uint8x8_t invAlpha = vdup_n_u8(255 - alpha);
+    uint16x8_t srcLo = vmull_u8(vget_low_u8(srcBytes), vdup_n_u8(alpha));
+    uint16x8_t srcHi = vmull_u8(vget_high_u8(srcBytes), vdup_n_u8(alpha));
+    uint8x16_t padding = vreinterpretq_u8_u32(vdupq_n_u32(paddingMask));
+
+    for (; i + 4 <= rowLength; i += 4)
+    {
+        uint8x16_t target = vld1q_u8(dstRow + i * 4);
+        uint16x8_t lo = vmlal_u8(srcLo, vget_low_u8(target), invAlpha);
+        uint16x8_t hi = vmlal_u8(srcHi, vget_high_u8(target), invAlpha);
+        uint8x16_t result = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+        vst1q_u8(dstRow + i * 4, vorrq_u8(result, padding));
+    }
+    for (; i < rowLength; ++i)
+    {
+        uint32_t word;
+        std::memcpy(&word, dstRow + i * 4, 4);
+        word = BlendWord(color, word, alpha) | paddingMask;
+        std::memcpy(dstRow + i * 4, &word, 4);
+    }
+}
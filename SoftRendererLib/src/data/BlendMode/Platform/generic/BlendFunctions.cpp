@@ -613,4 +613,182 @@ void BlendFunctions::BlendRGBA32ToRGB24(uint8_t *dstRow,
                 break;
         }
     }
-}
\ No newline at end of file
+}
+
+#define XRGB32_CHUNK 256
+
+namespace
+{
+    // src * a + dst * (255 - a) for all four bytes of a word, two bytes per multiply
+    inline uint32_t BlendWord(uint32_t src, uint32_t dst, uint32_t alpha)
+    {
+        uint32_t invAlpha = 255 - alpha;
+        uint32_t rb = (((src & 0x00FF00FFu) * alpha + (dst & 0x00FF00FFu) * invAlpha) >> 8) & 0x00FF00FFu;
+        uint32_t ag = (((src >> 8) & 0x00FF00FFu) * alpha + ((dst >> 8) & 0x00FF00FFu) * invAlpha) & 0xFF00FF00u;
+        return rb | ag;
+    }
+
+    inline uint32_t TintWord(uint32_t src, uint32_t tint)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            result |= ((((src >> shift) & 0xFF) * ((tint >> shift) & 0xFF)) >> 8) << shift;
+        }
+        return result;
+    }
+
+    inline bool IsSimpleAlphaBlend(const BlendContext &context)
+    {
+        return context.colorBlendFactorSrc == BlendFactor::SourceAlpha &&
+               context.colorBlendFactorDst == BlendFactor::InverseSourceAlpha &&
+               context.colorBlendOperation == BlendOperation::Add;
+    }
+}
+
+void BlendFunctions::BlendXRGB32(uint8_t *dstRow,
+                                 const uint8_t *srcRow,
+                                 size_t rowLength,
+                                 const PixelFormatInfo &targetInfo,
+                                 const PixelFormatInfo &sourceInfo,
+                                 Coloring coloring,
+                                 bool useSolidColor,
+                                 BlendContext& context)
+{
+    if (!IsSimpleAlphaBlend(context))
+    {
+        BlendRowGeneric(dstRow, srcRow, rowLength, targetInfo, sourceInfo, coloring, useSolidColor, context);
+        return;
+    }
+
+    PixelConverter::ConvertFunc convertToARGB8888 = PixelConverter::GetConversionFunction(sourceInfo.format, PixelFormat::ARGB8888);
+    if (!convertToARGB8888)
+        return;
+
+    // XRGB8888 has the channel layout of ARGB8888, BGRX8888 is its byte swapped version.
+    // The source alpha ends up in the padding byte of the target layout
+    const bool swapToBGRX = targetInfo.format == PixelFormat::BGRX8888;
+    const uint32_t alphaShift = swapToBGRX ? 24 : 0;
+    const uint32_t paddingMask = 0xFFu << alphaShift;
+    const bool graySource = sourceInfo.format == PixelFormat::GRAYSCALE8;
+    const bool coloringOnly = context.mode == BlendMode::COLORINGONLY;
+
+    uint32_t colorFactor = coloring.colorEnabled ? coloring.color.data[0] : 0;
+    uint32_t tint;
+    std::memcpy(&tint, coloring.color.data, 4);
+    if (swapToBGRX)
+        tint = __builtin_bswap32(tint);
+
+    alignas(16) uint32_t srcWords[XRGB32_CHUNK];
+
+    for (size_t offset = 0; offset < rowLength; offset += XRGB32_CHUNK)
+    {
+        size_t count = std::min(rowLength - offset, static_cast<size_t>(XRGB32_CHUNK));
+        const uint8_t *src = srcRow + offset * sourceInfo.bytesPerPixel;
+        uint8_t *dst = dstRow + offset * 4;
+
+        convertToARGB8888(src, reinterpret_cast<uint8_t *>(srcWords), count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t color = swapToBGRX ? __builtin_bswap32(srcWords[i]) : srcWords[i];
+
+            uint32_t alpha;
+            if (graySource)
+                alpha = src[i] == 0 ? 0 : 255;
+            else if (coloringOnly)
+                alpha = 255;
+            else
+                alpha = (color >> alphaShift) & 0xFF;
+
+            if (colorFactor != 0)
+            {
+                color = TintWord(color, tint);
+                alpha = (alpha * colorFactor) >> 8;
+            }
+
+            if (alpha == 0)
+                continue;
+
+            // rows of sub textures and atlases need not be word aligned
+            uint32_t word;
+            if (alpha == 255)
+            {
+                word = color | paddingMask;
+            }
+            else
+            {
+                std::memcpy(&word, dst + i * 4, 4);
+                word = BlendWord(color, word, alpha) | paddingMask;
+            }
+            std::memcpy(dst + i * 4, &word, 4);
+        }
+    }
+}
+
+void BlendFunctions::BlendSolidRowXRGB32(uint8_t *dstRow,
+                                         const uint8_t *srcRow,
+                                         size_t rowLength,
+                                         const PixelFormatInfo &targetInfo,
+                                         const PixelFormatInfo &sourceInfo,
+                                         Coloring coloring,
+                                         bool useSolidColor,
+                                         BlendContext& context)
+{
+    if (!IsSimpleAlphaBlend(context))
+    {
+        BlendRowGeneric(dstRow, srcRow, rowLength, targetInfo, sourceInfo, coloring, useSolidColor, context);
+        return;
+    }
+
+    PixelConverter::ConvertFunc convertToARGB8888 = PixelConverter::GetConversionFunction(sourceInfo.format, PixelFormat::ARGB8888);
+    if (!convertToARGB8888)
+        return;
+
+    const bool swapToBGRX = targetInfo.format == PixelFormat::BGRX8888;
+    const uint32_t alphaShift = swapToBGRX ? 24 : 0;
+    const uint32_t paddingMask = 0xFFu << alphaShift;
+
+    uint32_t color;
+    convertToARGB8888(srcRow, reinterpret_cast<uint8_t *>(&color), 1);
+    if (swapToBGRX)
+        color = __builtin_bswap32(color);
+
+    uint32_t alpha = context.mode == BlendMode::COLORINGONLY ? 255 : (color >> alphaShift) & 0xFF;
+
+    if (coloring.colorEnabled && coloring.color.data[0] != 0)
+    {
+        uint32_t tint;
+        std::memcpy(&tint, coloring.color.data, 4);
+        if (swapToBGRX)
+            tint = __builtin_bswap32(tint);
+        color = TintWord(color, tint);
+        alpha = (alpha * coloring.color.data[0]) >> 8;
+    }
+
+    if (alpha == 0)
+        return;
+
+    if (alpha == 255)
+    {
+        const uint32_t word = color | paddingMask;
+        for (size_t i = 0; i < rowLength; ++i)
+            std::memcpy(dstRow + i * 4, &word, 4);
+        return;
+    }
+
+    // source contribution is the same for every pixel
+    const uint32_t invAlpha = 255 - alpha;
+    const uint32_t srcRB = (color & 0x00FF00FFu) * alpha;
+    const uint32_t srcAG = ((color >> 8) & 0x00FF00FFu) * alpha;
+
+    for (size_t i = 0; i < rowLength; ++i)
+    {
+        uint32_t d;
+        std::memcpy(&d, dstRow + i * 4, 4);
+        uint32_t rb = ((srcRB + (d & 0x00FF00FFu) * invAlpha) >> 8) & 0x00FF00FFu;
+        uint32_t ag = (srcAG + ((d >> 8) & 0x00FF00FFu) * invAlpha) & 0xFF00FF00u;
+        d = rb | ag | paddingMask;
+        std::memcpy(dstRow + i * 4, &d, 4);
+    }
+}
@@ -0,0 +1,282 @@
+#include "BlockTexture.h"
+#include "PixelFormat/PixelConverter.h"
+#include "../util/MemHandler.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Tergos2D;
+
+namespace
+{
+    inline uint16_t Pack565(int r, int g, int b)
+    {
+        return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+
+    inline void Unpack565(uint16_t color, uint8_t *argb)
+    {
+        uint8_t r = (color >> 11) & 0x1F;
+        uint8_t g = (color >> 5) & 0x3F;
+        uint8_t b = color & 0x1F;
+        argb[0] = 255;
+        argb[1] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        argb[2] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        argb[3] = static_cast<uint8_t>((b << 3) | (b >> 2));
+    }
+
+    inline int Distance(const uint8_t *a, const uint8_t *b)
+    {
+        int dr = a[1] - b[1], dg = a[2] - b[2], db = a[3] - b[3];
+        return dr * dr + dg * dg + db * db;
+    }
+}
+
+BlockTexture::BlockTexture(const Texture &input)
+    : width(input.GetWidth()), height(input.GetHeight())
+{
+    // encoders read rows, bring tiled textures back to linear first
+    const Texture source = input.GetLayout() == TextureLayout::LINEAR ? input : input.ConvertLayout(TextureLayout::LINEAR);
+    if (!source.GetData() || width == 0 || height == 0)
+    {
+        width = height = 0;
+        return;
+    }
+
+    PixelConverter::ConvertFunc toARGB = PixelConverter::GetConversionFunction(source.GetFormat(), PixelFormat::ARGB8888);
+    if (!toARGB)
+    {
+        width = height = 0;
+        return;
+    }
+
+    blocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocks.resize(static_cast<size_t>(blocksX) * blocksY * BLOCK_BYTES);
+
+    std::vector<uint8_t> rows(static_cast<size_t>(width) * 4 * BLOCK_SIZE);
+    uint8_t pixels[16][4];
+
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+        // convert the four source rows once, edge rows are repeated for partial blocks
+        for (uint32_t row = 0; row < BLOCK_SIZE; ++row)
+        {
+            uint32_t sy = std::min(by * BLOCK_SIZE + row, height - 1);
+            toARGB(source.GetData() + static_cast<size_t>(sy) * source.GetPitch(), rows.data() + static_cast<size_t>(row) * width * 4, width);
+        }
+
+        for (uint32_t bx = 0; bx < blocksX; ++bx)
+        {
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                uint32_t sx = std::min(bx * BLOCK_SIZE + (i & 3), width - 1);
+                std::memcpy(pixels[i], rows.data() + (static_cast<size_t>(i >> 2) * width + sx) * 4, 4);
+            }
+            uint8_t *block = blocks.data() + (static_cast<size_t>(by) * blocksX + bx) * BLOCK_BYTES;
+            EncodeBlock(pixels, block);
+
+            uint16_t color0 = block[0] | (block[1] << 8);
+            uint16_t color1 = block[2] | (block[3] << 8);
+            if (color0 <= color1)
+            {
+                uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+                for (uint32_t i = 0; i < 16 && !hasAlpha; ++i)
+                    hasAlpha = ((indices >> (2 * i)) & 3) == 3;
+            }
+        }
+    }
+}
+
+void BlockTexture::EncodeBlock(const uint8_t pixels[16][4], uint8_t *block)
+{
+    bool transparent[16];
+    bool anyTransparent = false;
+    int minC[3] = {255, 255, 255};
+    int maxC[3] = {0, 0, 0};
+    int mean[3] = {0, 0, 0};
+    int opaqueCount = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        transparent[i] = pixels[i][0] < 128;
+        anyTransparent |= transparent[i];
+        if (transparent[i])
+            continue;
+        for (int c = 0; c < 3; ++c)
+        {
+            minC[c] = std::min(minC[c], static_cast<int>(pixels[i][c + 1]));
+            maxC[c] = std::max(maxC[c], static_cast<int>(pixels[i][c + 1]));
+            mean[c] += pixels[i][c + 1];
+        }
+        ++opaqueCount;
+    }
+
+    if (opaqueCount == 0)
+    {
+        // color0 <= color1 with every index 3: fully transparent block
+        std::memset(block, 0, 4);
+        std::memset(block + 4, 0xFF, 4);
+        return;
+    }
+
+    // choose the bounding box diagonal that follows the color distribution
+    for (int c = 0; c < 3; ++c)
+        mean[c] /= opaqueCount;
+    int covRG = 0, covRB = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (transparent[i])
+            continue;
+        int dr = pixels[i][1] - mean[0];
+        covRG += dr * (pixels[i][2] - mean[1]);
+        covRB += dr * (pixels[i][3] - mean[2]);
+    }
+    if (covRG < 0)
+        std::swap(minC[1], maxC[1]);
+    if (covRB < 0)
+        std::swap(minC[2], maxC[2]);
+
+    // inset the box a little, the interpolated entries cover the ends
+    int start[3], end[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        int inset = (maxC[c] - minC[c]) / 16;
+        start[c] = std::clamp(maxC[c] - inset, 0, 255);
+        end[c] = std::clamp(minC[c] + inset, 0, 255);
+    }
+
+    uint16_t color0 = Pack565(start[0], start[1], start[2]);
+    uint16_t color1 = Pack565(end[0], end[1], end[2]);
+    // the endpoint order selects the palette mode
+    if (anyTransparent ? color0 > color1 : color0 < color1)
+        std::swap(color0, color1);
+    if (!anyTransparent && color0 == color1)
+    {
+        if (color1 > 0)
+            --color1;
+        else
+            ++color0;
+    }
+
+    block[0] = color0 & 0xFF;
+    block[1] = color0 >> 8;
+    block[2] = color1 & 0xFF;
+    block[3] = color1 >> 8;
+
+    uint8_t palette[4][4];
+    DecodePalette(block, palette);
+    int usable = anyTransparent ? 3 : 4;
+
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        uint32_t best = 3;
+        if (!transparent[i])
+        {
+            int bestDistance = Distance(pixels[i], palette[0]);
+            best = 0;
+            for (int p = 1; p < usable; ++p)
+            {
+                int distance = Distance(pixels[i], palette[p]);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+        }
+        indices |= best << (2 * i);
+    }
+
+    block[4] = indices & 0xFF;
+    block[5] = (indices >> 8) & 0xFF;
+    block[6] = (indices >> 16) & 0xFF;
+    block[7] = indices >> 24;
+}
+
+bool BlockTexture::DecodePalette(const uint8_t *block, uint8_t palette[4][4])
+{
+    uint16_t color0 = block[0] | (block[1] << 8);
+    uint16_t color1 = block[2] | (block[3] << 8);
+    Unpack565(color0, palette[0]);
+    Unpack565(color1, palette[1]);
+
+    if (color0 > color1)
+    {
+        palette[2][0] = palette[3][0] = 255;
+        for (int c = 1; c < 4; ++c)
+        {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+        return false;
+    }
+
+    palette[2][0] = 255;
+    for (int c = 1; c < 4; ++c)
+        palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c] + 1) / 2);
+    std::memset(palette[3], 0, 4);
+    return true;
+}
+
+void BlockTexture::DecodeRow(uint32_t blockY, uint32_t row, uint32_t firstBlock, uint32_t count, uint8_t *dst) const
+{
+    const uint8_t *block = GetBlockRow(blockY) + static_cast<size_t>(firstBlock) * BLOCK_BYTES;
+    uint8_t palette[4][4];
+    uint32_t *out = reinterpret_cast<uint32_t *>(dst);
+
+    for (uint32_t i = 0; i < count; ++i, block += BLOCK_BYTES)
+    {
+        DecodePalette(block, palette);
+        uint32_t colors[4];
+        std::memcpy(colors, palette, sizeof(colors));
+
+        // one byte of indices per pixel row, written as whole 32 bit pixels
+        uint8_t bits = block[4 + row];
+        out[0] = colors[bits & 3];
+        out[1] = colors[(bits >> 2) & 3];
+        out[2] = colors[(bits >> 4) & 3];
+        out[3] = colors[bits >> 6];
+        out += BLOCK_SIZE;
+    }
+}
+
+uint32_t BlockTexture::GetWidth() const
+{
+    return width;
+}
+
+uint32_t BlockTexture::GetHeight() const
+{
+    return height;
+}
+
+uint32_t BlockTexture::GetBlocksX() const
+{
+    return blocksX;
+}
+
+uint32_t BlockTexture::GetBlocksY() const
+{
+    return blocksY;
+}
+
+bool BlockTexture::IsEmpty() const
+{
+    return width == 0 || height == 0;
+}
+
+bool BlockTexture::HasAlpha() const
+{
+    return hasAlpha;
+}
+
+size_t BlockTexture::GetEncodedSize() const
+{
+    return blocks.size();
+}
+
+const uint8_t *BlockTexture::GetBlockRow(uint32_t blockY) const
+{
+    return blocks.data() + static_cast<size_t>(blockY) * blocksX * BLOCK_BYTES;
+}
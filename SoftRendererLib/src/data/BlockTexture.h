@@ -0,0 +1,56 @@
+#ifndef BLOCKTEXTURE_H
+#define BLOCKTEXTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Texture.h"
+
+// bytes of one compressed 4x4 block, 4 bits per pixel
+#define BLOCK_BYTES 8
+#define BLOCK_SIZE 4
+
+namespace Tergos2D
+{
+    /// @brief Fixed rate 4x4 block compressed texture in the BC1 layout (4 bpp).
+    /// Every block stores two RGB565 endpoints followed by 16 two bit palette indices.
+    /// With color0 > color1 the palette holds four opaque colors, otherwise three colors
+    /// and a fully transparent entry (punch-through alpha for sprites with hard edges).
+    class BlockTexture
+    {
+    public:
+        BlockTexture() = default;
+        /// @brief Encodes the texture, pixels with alpha below 128 become transparent
+        explicit BlockTexture(const Texture &source);
+        ~BlockTexture() = default;
+
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        uint32_t GetBlocksX() const;
+        uint32_t GetBlocksY() const;
+        bool IsEmpty() const;
+        /// @brief True if at least one block uses the transparent palette entry
+        bool HasAlpha() const;
+        size_t GetEncodedSize() const;
+
+        /// @brief First block of block row blockY
+        const uint8_t *GetBlockRow(uint32_t blockY) const;
+
+        /// @brief Expands the endpoints of a block into its ARGB8888 palette (A, R, G, B bytes)
+        /// @return true if the block uses the transparent entry
+        static bool DecodePalette(const uint8_t *block, uint8_t palette[4][4]);
+
+        /// @brief Decodes pixel row (0..3) of blocks [firstBlock, firstBlock + count) of block row blockY as ARGB8888
+        void DecodeRow(uint32_t blockY, uint32_t row, uint32_t firstBlock, uint32_t count, uint8_t *dst) const;
+
+    private:
+        static void EncodeBlock(const uint8_t pixels[16][4], uint8_t *block);
+
+        uint32_t width = 0, height = 0;
+        uint32_t blocksX = 0, blocksY = 0;
+        bool hasAlpha = false;
+        std::vector<uint8_t> blocks;
+    };
+}
+
+#endif // BLOCKTEXTURE_H
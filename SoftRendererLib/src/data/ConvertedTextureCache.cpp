@@ -0,0 +1,95 @@
+#include "ConvertedTextureCache.h"
+#include "PixelFormat/PixelConverter.h"
+#include "PixelFormat/PixelFormatInfo.h"
+#include <algorithm>
+#include <cstring>
+
+// the blend functions convert through fixed size stack buffers, tint in chunks
+#define CONVERTED_CACHE_CHUNK 256
+
+using namespace Tergos2D;
+
+ConvertedTextureCache::ConvertedTextureCache(size_t budgetBytes, uint32_t minUses)
+    : TextureCopyCache(budgetBytes, minUses, CONVERTED_CACHE_MAX_ENTRIES)
+{
+}
+
+Texture *ConvertedTextureCache::Get(const Texture &source, PixelFormat targetFormat, const BlendContext &context,
+                                    const Coloring &coloring, BlendFunc blendFunc)
+{
+    if (!source.GetData() || source.GetLayout() != TextureLayout::LINEAR)
+        return nullptr;
+
+    bool tinted;
+    if (context.mode == BlendMode::NOBLEND)
+    {
+        // same format draws are a copy already
+        if (source.GetFormat() == targetFormat)
+            return nullptr;
+        tinted = false;
+    }
+    else if (context.mode == BlendMode::COLORINGONLY && coloring.colorEnabled && coloring.color.data[0] == 255 &&
+             blendFunc && BlendFunctions::IsSourceOver(context))
+    {
+        tinted = true;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    ConvertedTextureKey key = {source.GetId(), targetFormat, tinted, 0};
+    if (tinted)
+        std::memcpy(&key.tint, coloring.color.data, sizeof(key.tint));
+
+    Entry &entry = Touch(key, source);
+    if (entry.copy.GetData())
+        return &entry.copy;
+    if (!WantsCopy(entry))
+        return nullptr;
+    if (!Convert(source, entry, context, coloring, blendFunc))
+        return nullptr;
+    return &entry.copy;
+}
+
+bool ConvertedTextureCache::Convert(const Texture &source, Entry &entry, const BlendContext &context,
+                                    const Coloring &coloring, BlendFunc blendFunc)
+{
+    PixelFormat targetFormat = entry.key.targetFormat;
+    uint32_t width = source.GetWidth();
+    uint32_t height = source.GetHeight();
+
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(source.GetFormat(), targetFormat);
+    if (!entry.key.tinted && !convertFunc)
+        return false;
+    Texture *copy = Allocate(entry, width, height, targetFormat);
+    if (!copy)
+        return false;
+
+    if (!entry.key.tinted)
+    {
+        for (uint32_t y = 0; y < height; ++y)
+            convertFunc(source.GetData() + static_cast<size_t>(y) * source.GetPitch(),
+                        copy->GetData() + static_cast<size_t>(y) * copy->GetPitch(), width);
+    }
+    else
+    {
+        // let the blend function apply the tint exactly like a direct draw would, over black
+        std::memset(copy->GetData(), 0, static_cast<size_t>(copy->GetPitch()) * height);
+        PixelFormatInfo sourceInfo = PixelFormatRegistry::GetInfo(source.GetFormat());
+        PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(targetFormat);
+        BlendContext bc = context;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; x += CONVERTED_CACHE_CHUNK)
+            {
+                uint32_t length = std::min<uint32_t>(CONVERTED_CACHE_CHUNK, width - x);
+                blendFunc(copy->GetData() + static_cast<size_t>(y) * copy->GetPitch() + static_cast<size_t>(x) * targetInfo.bytesPerPixel,
+                          source.GetData() + static_cast<size_t>(y) * source.GetPitch() + static_cast<size_t>(x) * sourceInfo.bytesPerPixel,
+                          length, targetInfo, sourceInfo, coloring, false, bc);
+            }
+        }
+    }
+
+    return true;
+}
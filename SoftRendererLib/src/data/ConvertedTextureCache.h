@@ -0,0 +1,62 @@
+#ifndef CONVERTEDTEXTURECACHE_H
+#define CONVERTEDTEXTURECACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include "Texture.h"
+#include "TextureCopyCache.h"
+#include "PixelFormat/PixelFormat.h"
+#include "BlendMode/BlendFunctions.h"
+
+#define CONVERTED_CACHE_DEFAULT_BUDGET (4u * 1024u * 1024u)
+#define CONVERTED_CACHE_MAX_ENTRIES 256
+
+namespace Tergos2D
+{
+    struct ConvertedTextureKey
+    {
+        uint64_t id;
+        PixelFormat targetFormat;
+        bool tinted;
+        uint32_t tint;
+
+        bool operator==(const ConvertedTextureKey &other) const
+        {
+            return id == other.id && targetFormat == other.targetFormat && tinted == other.tinted && tint == other.tint;
+        }
+
+        size_t Hash() const
+        {
+            return std::hash<uint64_t>()(id ^ (static_cast<uint64_t>(tint) << 20) ^
+                                         (static_cast<uint64_t>(targetFormat) << 56) ^ (tinted ? 1ull << 63 : 0));
+        }
+    };
+
+    /// @brief Keeps copies of frequently drawn opaque textures already converted to the target format,
+    /// optionally with the coloring applied. Drawing such a copy is a plain row copy.
+    /// Entries are keyed by texture id, target format and tint, and rebuilt when the texture version changes.
+    /// A texture is converted once it was requested minUses times, copies are dropped in LRU order
+    /// when they exceed the byte budget. Set it on a RenderContext2D to use it for BasicTextureRenderer draws.
+    class ConvertedTextureCache : public TextureCopyCache<ConvertedTextureKey>
+    {
+    public:
+        /// @param budgetBytes bytes of converted pixels kept at most
+        /// @param minUses requests of the same key before a copy is made, 1 converts on first use
+        explicit ConvertedTextureCache(size_t budgetBytes = CONVERTED_CACHE_DEFAULT_BUDGET, uint32_t minUses = 2);
+        ~ConvertedTextureCache() = default;
+
+        /// @brief Converted copy of source for a draw with the given (already resolved) blend context.
+        /// Only opaque draws qualify: NOBLEND into a different format, or COLORINGONLY with a fully
+        /// opaque tint and source over factors. The tinted copy is produced with blendFunc, so it matches a direct draw
+        /// up to what the blend function keeps of the destination at full tint alpha.
+        /// @return the copy, valid until the next call, or nullptr if the draw has to convert itself
+        Texture *Get(const Texture &source, PixelFormat targetFormat, const BlendContext &context,
+                     const Coloring &coloring, BlendFunc blendFunc);
+
+    private:
+        bool Convert(const Texture &source, Entry &entry, const BlendContext &context, const Coloring &coloring, BlendFunc blendFunc);
+    };
+}
+
+#endif // CONVERTEDTEXTURECACHE_H
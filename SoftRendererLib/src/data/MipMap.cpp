@@ -0,0 +1,147 @@
+#include "MipMap.h"
+#include "PixelFormat/PixelConverter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Tergos2D;
+
+// ARGB8888 pixels are filtered as words: even and odd bytes are split into two
+// 16 bit lanes each, so all four channels are accumulated with two integer adds.
+#define MIP_LANE_MASK 0x00FF00FFu
+
+namespace
+{
+    inline uint32_t EvenLanes(uint32_t pixel)
+    {
+        return pixel & MIP_LANE_MASK;
+    }
+
+    inline uint32_t OddLanes(uint32_t pixel)
+    {
+        return (pixel >> 8) & MIP_LANE_MASK;
+    }
+
+    /// @brief Divides both lane sums by 2^shift with rounding and packs them back into a pixel
+    inline uint32_t PackLanes(uint32_t even, uint32_t odd, uint32_t shift)
+    {
+        uint32_t round = (1u << shift) >> 1;
+        round |= round << 16;
+        return (((even + round) >> shift) & MIP_LANE_MASK) | ((((odd + round) >> shift) & MIP_LANE_MASK) << 8);
+    }
+}
+
+void MipMap::DownsampleBox(const uint32_t *src, uint32_t srcWidth, uint32_t srcHeight,
+                           uint32_t *dst, uint32_t dstWidth, uint32_t dstHeight)
+{
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        // odd sizes repeat the last row / column
+        const uint32_t *row0 = src + static_cast<size_t>(std::min(y * 2, srcHeight - 1)) * srcWidth;
+        const uint32_t *row1 = src + static_cast<size_t>(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth;
+        uint32_t *out = dst + static_cast<size_t>(y) * dstWidth;
+        for (uint32_t x = 0; x < dstWidth; ++x)
+        {
+            uint32_t x0 = std::min(x * 2, srcWidth - 1);
+            uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+            uint32_t even = EvenLanes(row0[x0]) + EvenLanes(row0[x1]) + EvenLanes(row1[x0]) + EvenLanes(row1[x1]);
+            uint32_t odd = OddLanes(row0[x0]) + OddLanes(row0[x1]) + OddLanes(row1[x0]) + OddLanes(row1[x1]);
+            out[x] = PackLanes(even, odd, 2);
+        }
+    }
+}
+
+void MipMap::DownsampleTent(const uint32_t *src, uint32_t srcWidth, uint32_t srcHeight,
+                            uint32_t *dst, uint32_t dstWidth, uint32_t dstHeight)
+{
+    static const uint32_t weights[4] = {1, 3, 3, 1};
+    // the weights sum up to 64, 64 * 255 still fits a 16 bit lane
+
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        const uint32_t *rows[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            int64_t sy = std::clamp<int64_t>(static_cast<int64_t>(y) * 2 - 1 + i, 0, srcHeight - 1);
+            rows[i] = src + static_cast<size_t>(sy) * srcWidth;
+        }
+        uint32_t *out = dst + static_cast<size_t>(y) * dstWidth;
+        for (uint32_t x = 0; x < dstWidth; ++x)
+        {
+            uint32_t columns[4];
+            for (int i = 0; i < 4; ++i)
+                columns[i] = static_cast<uint32_t>(std::clamp<int64_t>(static_cast<int64_t>(x) * 2 - 1 + i, 0, srcWidth - 1));
+
+            uint32_t even = 0;
+            uint32_t odd = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    uint32_t weight = weights[i] * weights[j];
+                    uint32_t pixel = rows[j][columns[i]];
+                    even += EvenLanes(pixel) * weight;
+                    odd += OddLanes(pixel) * weight;
+                }
+            }
+            out[x] = PackLanes(even, odd, 6);
+        }
+    }
+}
+
+std::vector<Texture> MipMap::BuildChain(const Texture &base, MipFilter filter, uint32_t maxLevels)
+{
+    std::vector<Texture> levels;
+    if (!base.GetData() || base.GetLayout() != TextureLayout::LINEAR)
+        return levels;
+
+    PixelFormat format = base.GetFormat();
+    PixelConverter::ConvertFunc toARGB = PixelConverter::GetConversionFunction(format, PixelFormat::ARGB8888);
+    PixelConverter::ConvertFunc fromARGB = PixelConverter::GetConversionFunction(PixelFormat::ARGB8888, format);
+    if (!toARGB || !fromARGB)
+        return levels;
+
+    uint32_t width = base.GetWidth();
+    uint32_t height = base.GetHeight();
+    std::vector<uint32_t> current(static_cast<size_t>(width) * height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        toARGB(base.GetData() + static_cast<size_t>(y) * base.GetPitch(),
+               reinterpret_cast<uint8_t *>(current.data() + static_cast<size_t>(y) * width), width);
+    }
+
+    std::vector<uint32_t> next;
+    while ((width > 1 || height > 1) && (maxLevels == 0 || levels.size() < maxLevels))
+    {
+        uint32_t nextWidth = std::max(width >> 1, 1u);
+        uint32_t nextHeight = std::max(height >> 1, 1u);
+        next.resize(static_cast<size_t>(nextWidth) * nextHeight);
+
+        if (filter == MipFilter::TENT)
+            DownsampleTent(current.data(), width, height, next.data(), nextWidth, nextHeight);
+        else
+            DownsampleBox(current.data(), width, height, next.data(), nextWidth, nextHeight);
+
+        Texture level(nextWidth, nextHeight, format);
+        for (uint32_t y = 0; y < nextHeight; ++y)
+        {
+            fromARGB(reinterpret_cast<const uint8_t *>(next.data() + static_cast<size_t>(y) * nextWidth),
+                     level.GetData() + static_cast<size_t>(y) * level.GetPitch(), nextWidth);
+        }
+        levels.push_back(std::move(level));
+
+        current.swap(next);
+        width = nextWidth;
+        height = nextHeight;
+    }
+    return levels;
+}
+
+uint32_t MipMap::SelectLevel(float scale, uint32_t levelCount)
+{
+    if (levelCount <= 1 || !(scale > 0.0f) || scale >= 1.0f)
+        return 0;
+    // level n is 1 / 2^n of the base size, use it as long as it is not smaller than the drawn size
+    int level = static_cast<int>(std::floor(std::log2(1.0f / scale)));
+    return static_cast<uint32_t>(std::clamp(level, 0, static_cast<int>(levelCount) - 1));
+}
@@ -0,0 +1,34 @@
+#ifndef MIPMAP_H
+#define MIPMAP_H
+
+#include <stdint.h>
+#include <vector>
+#include "Texture.h"
+
+namespace Tergos2D
+{
+    /// @brief Mip chain generation and level selection.
+    /// Levels halve each dimension (rounded down, at least 1) until 1x1 is reached.
+    class MipMap
+    {
+    public:
+        /// @brief Builds levels 1..n of the chain for a linear texture. Filtering is done in ARGB8888
+        /// and every level is derived from the unquantized previous one, so 16 bit formats don't lose precision per level
+        /// @param maxLevels upper bound for the returned levels, 0 for the full chain
+        /// @return the levels, empty if the format can't be converted
+        static std::vector<Texture> BuildChain(const Texture &base, MipFilter filter = MipFilter::BOX, uint32_t maxLevels = 0);
+
+        /// @brief Picks the smallest level that is still at least as large as the drawn size
+        /// @param scale drawn size relative to level 0
+        /// @param levelCount number of levels including level 0
+        static uint32_t SelectLevel(float scale, uint32_t levelCount);
+
+    private:
+        static void DownsampleBox(const uint32_t *src, uint32_t srcWidth, uint32_t srcHeight,
+                                  uint32_t *dst, uint32_t dstWidth, uint32_t dstHeight);
+        static void DownsampleTent(const uint32_t *src, uint32_t srcWidth, uint32_t srcHeight,
+                                   uint32_t *dst, uint32_t dstWidth, uint32_t dstHeight);
+    };
+}
+
+#endif // MIPMAP_H
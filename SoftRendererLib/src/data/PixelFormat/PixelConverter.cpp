@@ -21,6 +21,65 @@ namespace Tergos2D
         MemHandler::MemCopy(dst, src, count * 4);
     }
 
+    // the reverse kernels work on whole words where the pixel size allows it,
+    // plain indexed loops that compilers turn into vector permutes
+    void PixelConverter::Reverse(const uint8_t *src, uint8_t *dst, size_t count)
+    {
+        const uint8_t *last = src + count - 1;
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = last[-static_cast<ptrdiff_t>(i)];
+    }
+    void PixelConverter::Reverse2(const uint8_t *src, uint8_t *dst, size_t count)
+    {
+        size_t i = 0;
+        // two pixels per word, swapping the halves reverses the pair
+        for (; i + 2 <= count; i += 2)
+        {
+            uint32_t pair;
+            std::memcpy(&pair, src + (count - i - 2) * 2, 4);
+            pair = (pair >> 16) | (pair << 16);
+            std::memcpy(dst + i * 2, &pair, 4);
+        }
+        if (i < count)
+            std::memcpy(dst + i * 2, src, 2);
+    }
+    void PixelConverter::Reverse3(const uint8_t *src, uint8_t *dst, size_t count)
+    {
+        const uint8_t *last = src + (count - 1) * 3;
+        for (size_t i = 0; i < count; ++i, last -= 3, dst += 3)
+        {
+            dst[0] = last[0];
+            dst[1] = last[1];
+            dst[2] = last[2];
+        }
+    }
+    void PixelConverter::Reverse4(const uint8_t *src, uint8_t *dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t pixel;
+            std::memcpy(&pixel, src + (count - 1 - i) * 4, 4);
+            std::memcpy(dst + i * 4, &pixel, 4);
+        }
+    }
+
+    PixelConverter::ConvertFunc PixelConverter::GetReverseFunction(PixelFormat format)
+    {
+        switch (PixelFormatRegistry::GetInfo(format).bytesPerPixel)
+        {
+        case 4:
+            return Reverse4;
+        case 3:
+            return Reverse3;
+        case 2:
+            return Reverse2;
+        case 1:
+            return Reverse;
+        default:
+            return nullptr;
+        }
+    }
+
 
 
     PixelConverter::ConvertFunc PixelConverter::GetConversionFunction(PixelFormat from, PixelFormat to)
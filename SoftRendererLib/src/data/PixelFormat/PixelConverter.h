@@ -19,6 +19,10 @@ namespace Tergos2D
         // Convert pixels using cached function pointer and batch processing
         static void Convert(PixelFormat from, PixelFormat to, const uint8_t *src, uint8_t *dst, size_t count = 1);
 
+        // Copy count pixels in reverse order (dst[i] = src[count - 1 - i]) without converting,
+        // used for mirrored blits. src and dst must not overlap
+        static ConvertFunc GetReverseFunction(PixelFormat format);
+
     private:
         struct Conversion
         {
@@ -32,6 +36,11 @@ namespace Tergos2D
         static void Move3(const uint8_t *src, uint8_t *dst, size_t count);
         static void Move4(const uint8_t *src, uint8_t *dst, size_t count);
 
+        static void Reverse(const uint8_t *src, uint8_t *dst, size_t count);
+        static void Reverse2(const uint8_t *src, uint8_t *dst, size_t count);
+        static void Reverse3(const uint8_t *src, uint8_t *dst, size_t count);
+        static void Reverse4(const uint8_t *src, uint8_t *dst, size_t count);
+
         // BGR24 Conversions
         static void BGR24ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count);
         static void BGR24ToRGBA8888(const uint8_t *src, uint8_t *dst, size_t count);
@@ -86,6 +95,28 @@ namespace Tergos2D
         static void Grayscale8ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count);
         static void Grayscale8ToRGB565(const uint8_t *src, uint8_t *dst, size_t count);
 
+        // 32 bit targets without alpha (XRGB8888 / BGRX8888), processed as whole words
+        static void RGB24ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGR24ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void RGB24ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGR24ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void ARGB8888ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void RGBA8888ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void RGB565ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void ARGB1555ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void RGBA4444ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void Grayscale8ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void Grayscale8ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRA8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+
+        static void XRGB8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void XRGB8888ToRGBA8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRX8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRX8888ToBGRA8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRX8888ToRGBA8888(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRX8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t count);
+        static void BGRX8888ToBGR24(const uint8_t *src, uint8_t *dst, size_t count);
+
 
         // Conversion mappings
         static constexpr Conversion defaultConversions[] = {
@@ -119,6 +150,9 @@ namespace Tergos2D
             {PixelFormat::RGBA8888, PixelFormat::ARGB8888, RGBA8888ToARGB8888},
 
             {PixelFormat::BGRA8888, PixelFormat::RGB565, BGRA8888ToRGB565},
+            {PixelFormat::BGRA8888, PixelFormat::ARGB8888, BGRA8888ToARGB8888},
+            {PixelFormat::BGRA8888, PixelFormat::XRGB8888, BGRA8888ToARGB8888},
+            {PixelFormat::BGRA8888, PixelFormat::BGRX8888, Move4},
 
 
             // RGB565 conversions
@@ -144,6 +178,44 @@ namespace Tergos2D
             {PixelFormat::GRAYSCALE8, PixelFormat::ARGB8888,Grayscale8ToARGB8888},
             {PixelFormat::GRAYSCALE8, PixelFormat::RGB565,Grayscale8ToRGB565},
 
+            // Conversions into XRGB8888 / BGRX8888, the padding byte is don't care
+            // so formats sharing the channel layout reuse the ARGB8888 functions
+            {PixelFormat::ARGB8888, PixelFormat::XRGB8888, Move4},
+            {PixelFormat::RGBA8888, PixelFormat::XRGB8888, RGBA8888ToARGB8888},
+            {PixelFormat::RGB24, PixelFormat::XRGB8888, RGB24ToXRGB8888},
+            {PixelFormat::BGR24, PixelFormat::XRGB8888, BGR24ToXRGB8888},
+            {PixelFormat::RGB565, PixelFormat::XRGB8888, RGB565ToARGB8888},
+            {PixelFormat::ARGB1555, PixelFormat::XRGB8888, ARGB1555ToARGB8888},
+            {PixelFormat::RGBA4444, PixelFormat::XRGB8888, RGBA4444ToARGB8888},
+            {PixelFormat::GRAYSCALE8, PixelFormat::XRGB8888, Grayscale8ToXRGB8888},
+
+            {PixelFormat::ARGB8888, PixelFormat::BGRX8888, ARGB8888ToBGRX8888},
+            {PixelFormat::RGBA8888, PixelFormat::BGRX8888, RGBA8888ToBGRX8888},
+            {PixelFormat::RGB24, PixelFormat::BGRX8888, RGB24ToBGRX8888},
+            {PixelFormat::BGR24, PixelFormat::BGRX8888, BGR24ToBGRX8888},
+            {PixelFormat::RGB565, PixelFormat::BGRX8888, RGB565ToBGRX8888},
+            {PixelFormat::ARGB1555, PixelFormat::BGRX8888, ARGB1555ToBGRX8888},
+            {PixelFormat::RGBA4444, PixelFormat::BGRX8888, RGBA4444ToBGRX8888},
+            {PixelFormat::GRAYSCALE8, PixelFormat::BGRX8888, Grayscale8ToBGRX8888},
+
+            // XRGB8888 conversions
+            {PixelFormat::XRGB8888, PixelFormat::ARGB8888, XRGB8888ToARGB8888},
+            {PixelFormat::XRGB8888, PixelFormat::RGBA8888, XRGB8888ToRGBA8888},
+            {PixelFormat::XRGB8888, PixelFormat::BGRX8888, ARGB8888ToBGRX8888},
+            {PixelFormat::XRGB8888, PixelFormat::RGB24, ARGB8888ToRGB24},
+            {PixelFormat::XRGB8888, PixelFormat::BGR24, ARGB8888ToBGR24},
+            {PixelFormat::XRGB8888, PixelFormat::RGB565, ARGB8888ToRGB565},
+            {PixelFormat::XRGB8888, PixelFormat::GRAYSCALE8, ARGB8888ToGrayscale8},
+
+            // BGRX8888 conversions
+            {PixelFormat::BGRX8888, PixelFormat::ARGB8888, BGRX8888ToARGB8888},
+            {PixelFormat::BGRX8888, PixelFormat::XRGB8888, BGRX8888ToARGB8888},
+            {PixelFormat::BGRX8888, PixelFormat::BGRA8888, BGRX8888ToBGRA8888},
+            {PixelFormat::BGRX8888, PixelFormat::RGBA8888, BGRX8888ToRGBA8888},
+            {PixelFormat::BGRX8888, PixelFormat::RGB24, BGRX8888ToRGB24},
+            {PixelFormat::BGRX8888, PixelFormat::BGR24, BGRX8888ToBGR24},
+            {PixelFormat::BGRX8888, PixelFormat::RGB565, BGRA8888ToRGB565},
+
         };
     };
 }
@@ -15,7 +15,9 @@ namespace Tergos2D
         RGB565 = 6, // 16 bits: 5 bits R, 6 bits G, 5 bits B
         RGBA4444 = 7,
         GRAYSCALE8 = 8, // 8 bits grayscale
-        COUNT = 9
+        XRGB8888 = 9, // 32 bits: padding byte, R, G, B (no alpha)
+        BGRX8888 = 10, // 32 bits: B, G, R, padding byte (DRM XRGB8888 on little endian)
+        COUNT = 11
     };
 
 }
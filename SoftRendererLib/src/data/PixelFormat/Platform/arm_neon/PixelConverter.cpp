@@ -68,7 +68,7 @@ void PixelConverter::RGB24ToARGB8888(const uint8_t *src, uint8_t *dst, size_t co
 void PixelConverter::ARGB8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t count)
 {
     size_t i = 0;
-    for (; i + 4 <= count; i += 4)
+    for (; i + 16 <= count; i += 16)
     {
         uint8x16x4_t argb = vld4q_u8(src + i * 4);
 
@@ -92,7 +92,7 @@ void PixelConverter::ARGB8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t co
 void PixelConverter::ARGB8888ToBGR24(const uint8_t *src, uint8_t *dst, size_t count)
 {
     size_t i = 0;
-    for (; i + 4 <= count; i += 4)
+    for (; i + 16 <= count; i += 16)
     {
         uint8x16x4_t argb = vld4q_u8(src + i * 4);
 
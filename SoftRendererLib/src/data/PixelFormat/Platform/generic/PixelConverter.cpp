@@ -28,7 +28,7 @@ void PixelConverter::RGB24ToARGB8888(const uint8_t *src, uint8_t *dst, size_t co
 void PixelConverter::ARGB8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t count)
 {
     size_t i = 0;
-    for (; i + 3 <= count; i += 4)
+    for (; i + 4 <= count; i += 4)
     {
         // Process 4 pixels at once
         const uint8_t *src_0 = src + 4 * i;
@@ -66,7 +66,7 @@ void PixelConverter::ARGB8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t co
 void PixelConverter::ARGB8888ToBGR24(const uint8_t *src, uint8_t *dst, size_t count)
 {
     size_t i = 0;
-    for (; i + 3 <= count; i += 4)
+    for (; i + 4 <= count; i += 4)
     {
         // Process 4 pixels at once
         const uint8_t *src_0 = src + 4 * i;
@@ -160,7 +160,7 @@ void PixelConverter::RGB565ToRGB24(const uint8_t *src, uint8_t *dst, size_t coun
 void PixelConverter::RGB565ToBGR24(const uint8_t *src, uint8_t *dst, size_t count)
 {
     size_t i = 0;
-    for (; i + 3 <= count; i += 4)
+    for (; i + 4 <= count; i += 4)
     {
         // Process 4 pixels at once
         uint16_t rgb565_0 = (src[2 * i] << 8) | src[2 * i + 1];
@@ -594,4 +594,213 @@ void Tergos2D::PixelConverter::Grayscale8ToRGB565(const uint8_t* src, uint8_t* d
         uint8_t gray = *src++;
         *dst16++ = ((gray & 0xF8) << 8) | ((gray & 0xFC) << 3) | (gray >> 3);
     }
-}
\ No newline at end of file
+}
+
+// 32 bit target formats (XRGB8888 / BGRX8888)
+// all pixels are handled as little endian words, 24 bit sources are read as
+// 3 words per 4 pixels so the inner loops never touch single bytes
+namespace
+{
+    inline uint32_t Load32(const uint8_t *p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline void Store32(uint8_t *p, uint32_t v)
+    {
+        std::memcpy(p, &v, 4);
+    }
+
+    // swaps byte 0 and byte 2 of a word, RGB <-> BGR
+    inline uint32_t SwapRB(uint32_t v)
+    {
+        return (v & 0xFF00FF00u) | ((v & 0xFFu) << 16) | ((v >> 16) & 0xFFu);
+    }
+
+    // Expands 24 bit pixels into words holding the pixel in the low 3 bytes,
+    // op maps that word to the final 32 bit pixel
+    template <typename Op>
+    inline void Expand24To32(const uint8_t *src, uint8_t *dst, size_t count, Op op)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, src += 12, dst += 16)
+        {
+            uint32_t w0 = Load32(src);
+            uint32_t w1 = Load32(src + 4);
+            uint32_t w2 = Load32(src + 8);
+
+            Store32(dst, op(w0 & 0xFFFFFFu));
+            Store32(dst + 4, op(((w0 >> 24) | (w1 << 8)) & 0xFFFFFFu));
+            Store32(dst + 8, op(((w1 >> 16) | (w2 << 16)) & 0xFFFFFFu));
+            Store32(dst + 12, op(w2 >> 8));
+        }
+        for (; i < count; ++i, src += 3, dst += 4)
+        {
+            Store32(dst, op(src[0] | (src[1] << 8) | (src[2] << 16)));
+        }
+    }
+
+    // Packs words holding a pixel in the low 3 bytes (after op) into 24 bit pixels
+    template <typename Op>
+    inline void Pack32To24(const uint8_t *src, uint8_t *dst, size_t count, Op op)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, src += 16, dst += 12)
+        {
+            uint32_t p0 = op(Load32(src)) & 0xFFFFFFu;
+            uint32_t p1 = op(Load32(src + 4)) & 0xFFFFFFu;
+            uint32_t p2 = op(Load32(src + 8)) & 0xFFFFFFu;
+            uint32_t p3 = op(Load32(src + 12)) & 0xFFFFFFu;
+
+            Store32(dst, p0 | (p1 << 24));
+            Store32(dst + 4, (p1 >> 8) | (p2 << 16));
+            Store32(dst + 8, (p2 >> 16) | (p3 << 8));
+        }
+        for (; i < count; ++i, src += 4, dst += 3)
+        {
+            uint32_t p = op(Load32(src));
+            dst[0] = p & 0xFF;
+            dst[1] = (p >> 8) & 0xFF;
+            dst[2] = (p >> 16) & 0xFF;
+        }
+    }
+
+    template <typename Op>
+    inline void Map32(const uint8_t *src, uint8_t *dst, size_t count, Op op)
+    {
+        for (size_t i = 0; i < count; ++i, src += 4, dst += 4)
+        {
+            Store32(dst, op(Load32(src)));
+        }
+    }
+}
+
+void PixelConverter::RGB24ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Expand24To32(src, dst, count, [](uint32_t p) { return (p << 8) | 0xFFu; });
+}
+
+void PixelConverter::BGR24ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Expand24To32(src, dst, count, [](uint32_t p) { return (SwapRB(p) << 8) | 0xFFu; });
+}
+
+void PixelConverter::RGB24ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Expand24To32(src, dst, count, [](uint32_t p) { return SwapRB(p) | 0xFF000000u; });
+}
+
+void PixelConverter::BGR24ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Expand24To32(src, dst, count, [](uint32_t p) { return p | 0xFF000000u; });
+}
+
+void PixelConverter::ARGB8888ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return __builtin_bswap32(p) | 0xFF000000u; });
+}
+
+void PixelConverter::RGBA8888ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return SwapRB(p) | 0xFF000000u; });
+}
+
+void PixelConverter::BGRA8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return __builtin_bswap32(p); });
+}
+
+void PixelConverter::XRGB8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return p | 0xFFu; });
+}
+
+void PixelConverter::XRGB8888ToRGBA8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return (p >> 8) | 0xFF000000u; });
+}
+
+void PixelConverter::BGRX8888ToARGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return __builtin_bswap32(p) | 0xFFu; });
+}
+
+void PixelConverter::BGRX8888ToBGRA8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return p | 0xFF000000u; });
+}
+
+void PixelConverter::BGRX8888ToRGBA8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Map32(src, dst, count, [](uint32_t p) { return SwapRB(p) | 0xFF000000u; });
+}
+
+void PixelConverter::BGRX8888ToRGB24(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Pack32To24(src, dst, count, [](uint32_t p) { return SwapRB(p); });
+}
+
+void PixelConverter::BGRX8888ToBGR24(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    Pack32To24(src, dst, count, [](uint32_t p) { return p; });
+}
+
+void PixelConverter::RGB565ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, src += 2, dst += 4)
+    {
+        uint32_t pixel = src[0] | (src[1] << 8);
+
+        uint32_t r5 = (pixel >> 11) & 0x1F;
+        uint32_t g6 = (pixel >> 5) & 0x3F;
+        uint32_t b5 = pixel & 0x1F;
+
+        uint32_t r8 = (r5 << 3) | (r5 >> 2);
+        uint32_t g8 = (g6 << 2) | (g6 >> 4);
+        uint32_t b8 = (b5 << 3) | (b5 >> 2);
+
+        Store32(dst, b8 | (g8 << 8) | (r8 << 16) | 0xFF000000u);
+    }
+}
+
+void PixelConverter::ARGB1555ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, src += 2, dst += 4)
+    {
+        uint32_t pixel = src[0] | (src[1] << 8);
+        uint32_t r = (pixel & 0x7C00) >> 7;
+        uint32_t g = (pixel & 0x03E0) >> 2;
+        uint32_t b = (pixel & 0x001F) << 3;
+        Store32(dst, b | (g << 8) | (r << 16) | 0xFF000000u);
+    }
+}
+
+void PixelConverter::RGBA4444ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, src += 2, dst += 4)
+    {
+        uint32_t pixel = src[0] | (src[1] << 8);
+        uint32_t r = (pixel & 0xF000) >> 8;
+        uint32_t g = (pixel & 0x0F00) >> 4;
+        uint32_t b = (pixel & 0x00F0);
+        Store32(dst, b | (g << 8) | (r << 16) | 0xFF000000u);
+    }
+}
+
+void PixelConverter::Grayscale8ToXRGB8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, dst += 4)
+    {
+        Store32(dst, (src[i] * 0x01010100u) | 0xFFu);
+    }
+}
+
+void PixelConverter::Grayscale8ToBGRX8888(const uint8_t *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i, dst += 4)
+    {
+        Store32(dst, (src[i] * 0x00010101u) | 0xFF000000u);
+    }
+}
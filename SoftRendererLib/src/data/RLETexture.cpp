@@ -0,0 +1,105 @@
+#include "RLETexture.h"
+#include "PixelFormat/PixelConverter.h"
+
+#define MAX_RLE_PIXEL_BYTES 4
+
+using namespace Tergos2D;
+
+RLETexture::RLETexture(const Texture &input)
+    : format(input.GetFormat()), width(input.GetWidth()), height(input.GetHeight())
+{
+    // encoders read rows, bring tiled textures back to linear first
+    const Texture source = input.GetLayout() == TextureLayout::LINEAR ? input : input.ConvertLayout(TextureLayout::LINEAR);
+    if (!source.GetData())
+    {
+        width = height = 0;
+        return;
+    }
+
+    const PixelFormatInfo &info = PixelFormatRegistry::GetInfo(format);
+    uint8_t opaqueAlpha = OpaqueAlpha(format);
+    rowRunOffsets.reserve(height + 1);
+    rowPixelOffsets.reserve(height);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const uint8_t *row = source.GetData() + static_cast<size_t>(y) * source.GetPitch();
+        rowRunOffsets.push_back(static_cast<uint32_t>(runs.size()));
+        rowPixelOffsets.push_back(static_cast<uint32_t>(pixels.size()));
+
+        uint32_t x = 0;
+        while (x < width)
+        {
+            RLERunType type = Classify(row + static_cast<size_t>(x) * info.bytesPerPixel, format, info, opaqueAlpha);
+            uint32_t length = 1;
+            while (x + length < width && length < RLE_MAX_RUN &&
+                   Classify(row + static_cast<size_t>(x + length) * info.bytesPerPixel, format, info, opaqueAlpha) == type)
+            {
+                ++length;
+            }
+
+            runs.push_back(static_cast<uint8_t>((static_cast<uint8_t>(type) << 6) | (length - 1)));
+            if (type != RLERunType::TRANSPARENT)
+            {
+                const uint8_t *runPixels = row + static_cast<size_t>(x) * info.bytesPerPixel;
+                pixels.insert(pixels.end(), runPixels, runPixels + static_cast<size_t>(length) * info.bytesPerPixel);
+            }
+            x += length;
+        }
+    }
+    rowRunOffsets.push_back(static_cast<uint32_t>(runs.size()));
+}
+
+uint32_t RLETexture::GetWidth() const
+{
+    return width;
+}
+
+uint32_t RLETexture::GetHeight() const
+{
+    return height;
+}
+
+PixelFormat RLETexture::GetFormat() const
+{
+    return format;
+}
+
+bool RLETexture::IsEmpty() const
+{
+    return width == 0 || height == 0;
+}
+
+size_t RLETexture::GetEncodedSize() const
+{
+    return runs.size() + pixels.size();
+}
+
+RLERunType RLETexture::Classify(const uint8_t *pixel, PixelFormat format, const PixelFormatInfo &info, uint8_t opaqueAlpha)
+{
+    if (!info.hasAlpha)
+        return RLERunType::OPAQUE;
+
+    uint8_t argb[4];
+    PixelConverter::Convert(format, PixelFormat::ARGB8888, pixel, argb, 1);
+    if (argb[0] == 0)
+        return RLERunType::TRANSPARENT;
+    if (argb[0] >= opaqueAlpha)
+        return RLERunType::OPAQUE;
+    return RLERunType::LITERAL;
+}
+
+uint8_t RLETexture::OpaqueAlpha(PixelFormat format)
+{
+    // alpha of a fully opaque pixel after expanding to 8 bit, e.g. 0xF0 for RGBA4444
+    PixelConverter::ConvertFunc toFormat = PixelConverter::GetConversionFunction(PixelFormat::ARGB8888, format);
+    PixelConverter::ConvertFunc toARGB = PixelConverter::GetConversionFunction(format, PixelFormat::ARGB8888);
+    if (!toFormat || !toARGB)
+        return 255;
+
+    uint8_t opaque[4] = {255, 255, 255, 255};
+    uint8_t encoded[MAX_RLE_PIXEL_BYTES];
+    toFormat(opaque, encoded, 1);
+    toARGB(encoded, opaque, 1);
+    return opaque[0];
+}
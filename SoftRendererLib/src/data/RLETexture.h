@@ -0,0 +1,98 @@
+#ifndef RLETEXTURE_H
+#define RLETEXTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+#include "Texture.h"
+#include "PixelFormat/PixelFormat.h"
+#include "PixelFormat/PixelFormatInfo.h"
+
+// longest run a single control byte can describe
+#define RLE_MAX_RUN 64
+
+namespace Tergos2D
+{
+    enum class RLERunType : uint8_t
+    {
+        TRANSPARENT = 0, // alpha 0, no pixels stored
+        OPAQUE = 1,      // alpha 255, can be copied without blending
+        LITERAL = 2      // partially transparent, has to be blended
+    };
+
+    /// @brief Span of one row handed to the renderers, already clipped to the requested range
+    struct RLERun
+    {
+        RLERunType type;
+        uint32_t start;        // first source column
+        uint32_t length;       // pixels in the span
+        const uint8_t *pixels; // first pixel of the span, nullptr for transparent runs
+    };
+
+    /// @brief Run length encoded texture for sparse overlays.
+    /// Every row is a list of control bytes (type in the upper 2 bits, length - 1 in the lower 6)
+    /// and a separate pixel stream holding only the non transparent pixels in the source format,
+    /// so pixel data stays aligned and runs decode straight into the convert/blend kernels.
+    class RLETexture
+    {
+    public:
+        RLETexture() = default;
+        /// @brief Encodes the texture, pixels keep the texture's format
+        explicit RLETexture(const Texture &source);
+        ~RLETexture() = default;
+
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        PixelFormat GetFormat() const;
+        bool IsEmpty() const;
+
+        /// @brief Bytes used by control and pixel streams
+        size_t GetEncodedSize() const;
+
+        /// @brief Calls func(const RLERun&) for every run of row y overlapping [startX, endX), clipped to that range
+        template <typename Func>
+        void ForEachRun(uint32_t y, uint32_t startX, uint32_t endX, Func &&func) const
+        {
+            const uint8_t *control = runs.data() + rowRunOffsets[y];
+            const uint8_t *controlEnd = runs.data() + rowRunOffsets[y + 1];
+            const uint8_t *rowPixels = pixels.data() + rowPixelOffsets[y];
+            uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+
+            uint32_t x = 0;
+            for (; control < controlEnd && x < endX; ++control)
+            {
+                RLERunType type = static_cast<RLERunType>(*control >> 6);
+                uint32_t length = (*control & 0x3F) + 1u;
+                uint32_t runEnd = x + length;
+
+                if (runEnd > startX)
+                {
+                    uint32_t spanStart = std::max(x, startX);
+                    uint32_t spanEnd = std::min(runEnd, endX);
+                    const uint8_t *spanPixels = type == RLERunType::TRANSPARENT
+                                                    ? nullptr
+                                                    : rowPixels + static_cast<size_t>(spanStart - x) * bytesPerPixel;
+                    func(RLERun{type, spanStart, spanEnd - spanStart, spanPixels});
+                }
+
+                if (type != RLERunType::TRANSPARENT)
+                    rowPixels += static_cast<size_t>(length) * bytesPerPixel;
+                x = runEnd;
+            }
+        }
+
+    private:
+        static RLERunType Classify(const uint8_t *pixel, PixelFormat format, const PixelFormatInfo &info, uint8_t opaqueAlpha);
+        static uint8_t OpaqueAlpha(PixelFormat format);
+
+        PixelFormat format = PixelFormat::ARGB8888;
+        uint32_t width = 0, height = 0;
+        std::vector<uint8_t> runs;
+        std::vector<uint8_t> pixels;
+        std::vector<uint32_t> rowRunOffsets;   // height + 1 entries
+        std::vector<uint32_t> rowPixelOffsets; // height entries
+    };
+}
+
+#endif // RLETEXTURE_H
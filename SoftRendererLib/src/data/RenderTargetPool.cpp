@@ -0,0 +1,115 @@
+#include "RenderTargetPool.h"
+#include <algorithm>
+
+using namespace Tergos2D;
+
+RenderTargetPool::RenderTargetPool(uint32_t inMaxIdleFrames) : maxIdleFrames(inMaxIdleFrames)
+{
+}
+
+uint32_t RenderTargetPool::SizeClass(uint32_t size)
+{
+    uint32_t sizeClass = RENDER_TARGET_MIN_CLASS;
+    while (sizeClass < size && sizeClass < (1u << 31))
+        sizeClass <<= 1;
+    return std::max(sizeClass, size);
+}
+
+Texture *RenderTargetPool::Acquire(uint32_t width, uint32_t height, PixelFormat format)
+{
+    if (width == 0 || height == 0)
+        return nullptr;
+
+    uint32_t classWidth = SizeClass(width);
+    uint32_t classHeight = SizeClass(height);
+
+    Entry *found = nullptr;
+    for (auto &entry : entries)
+    {
+        if (!entry->inUse && entry->format == format &&
+            entry->classWidth == classWidth && entry->classHeight == classHeight)
+        {
+            found = entry.get();
+            break;
+        }
+    }
+
+    if (!found)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->storage = Texture(classWidth, classHeight, format);
+        if (!entry->storage.GetData())
+            return nullptr;
+        entry->format = format;
+        entry->classWidth = classWidth;
+        entry->classHeight = classHeight;
+        found = entry.get();
+        entries.push_back(std::move(entry));
+    }
+
+    found->target = found->storage.SubTexture(0, 0, width, height);
+    found->idleFrames = 0;
+    found->inUse = true;
+    return &found->target;
+}
+
+void RenderTargetPool::Release(Texture *target)
+{
+    for (auto &entry : entries)
+    {
+        if (&entry->target == target)
+        {
+            entry->inUse = false;
+            entry->target = Texture();
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::EndFrame()
+{
+    for (auto &entry : entries)
+    {
+        if (entry->inUse)
+        {
+            entry->inUse = false;
+            entry->target = Texture();
+        }
+        else
+        {
+            entry->idleFrames++;
+        }
+    }
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [this](const std::unique_ptr<Entry> &entry)
+                                 { return entry->idleFrames > maxIdleFrames; }),
+                  entries.end());
+}
+
+void RenderTargetPool::Trim()
+{
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const std::unique_ptr<Entry> &entry)
+                                 { return !entry->inUse; }),
+                  entries.end());
+}
+
+size_t RenderTargetPool::GetAllocatedBytes() const
+{
+    size_t bytes = 0;
+    for (const auto &entry : entries)
+        bytes += static_cast<size_t>(entry->storage.GetPitch()) * entry->storage.GetHeight();
+    return bytes;
+}
+
+size_t RenderTargetPool::GetTargetCount() const
+{
+    return entries.size();
+}
+
+size_t RenderTargetPool::GetTargetsInUse() const
+{
+    return std::count_if(entries.begin(), entries.end(),
+                         [](const std::unique_ptr<Entry> &entry) { return entry->inUse; });
+}
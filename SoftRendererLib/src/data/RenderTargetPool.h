@@ -0,0 +1,68 @@
+#ifndef RENDERTARGETPOOL_H
+#define RENDERTARGETPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include "Texture.h"
+#include "PixelFormat/PixelFormat.h"
+
+// smallest size class edge, smaller requests share the 16x16 class
+#define RENDER_TARGET_MIN_CLASS 16
+
+namespace Tergos2D
+{
+    /// @brief Recycles temporary render targets (layers, shadows, cached composites).
+    /// Requests are rounded up to power of two size classes per format, released
+    /// targets keep their storage and are handed out again for the same class.
+    /// Storage that stays unused for more than maxIdleFrames frames is freed at EndFrame.
+    class RenderTargetPool
+    {
+    public:
+        /// @param maxIdleFrames frames a released target is kept before its storage is freed
+        explicit RenderTargetPool(uint32_t maxIdleFrames = 2);
+        ~RenderTargetPool() = default;
+
+        RenderTargetPool(const RenderTargetPool &) = delete;
+        RenderTargetPool &operator=(const RenderTargetPool &) = delete;
+
+        /// @brief Hands out a target of exactly width x height, its pixel content is undefined.
+        /// The pointer stays valid until the target is released
+        /// @return nullptr for empty sizes or if the allocation fails
+        Texture *Acquire(uint32_t width, uint32_t height, PixelFormat format);
+
+        /// @brief Returns a target before the end of the frame, copies of it must not be used afterwards
+        void Release(Texture *target);
+
+        /// @brief Releases every target handed out this frame and frees storage idle for too long
+        void EndFrame();
+
+        /// @brief Frees the storage of all targets that are not in use
+        void Trim();
+
+        /// @brief Bytes currently held by the pool, in use or not
+        size_t GetAllocatedBytes() const;
+        size_t GetTargetCount() const;
+        size_t GetTargetsInUse() const;
+
+    private:
+        struct Entry
+        {
+            Texture storage;    // size class allocation
+            Texture target;     // requested size, shares the allocation
+            PixelFormat format;
+            uint32_t classWidth;
+            uint32_t classHeight;
+            uint32_t idleFrames = 0;
+            bool inUse = false;
+        };
+
+        static uint32_t SizeClass(uint32_t size);
+
+        std::vector<std::unique_ptr<Entry>> entries;
+        uint32_t maxIdleFrames;
+    };
+}
+
+#endif // RENDERTARGETPOOL_H
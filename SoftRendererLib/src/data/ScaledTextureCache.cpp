@@ -0,0 +1,26 @@
+#include "ScaledTextureCache.h"
+
+using namespace Tergos2D;
+
+ScaledTextureCache::ScaledTextureCache(size_t budgetBytes, uint32_t minUses)
+    : TextureCopyCache(budgetBytes, minUses, SCALED_CACHE_MAX_ENTRIES)
+{
+}
+
+Texture *ScaledTextureCache::Acquire(const Texture &source, uint32_t width, uint32_t height, uint32_t filter,
+                                     PixelFormat format, bool &filled)
+{
+    filled = false;
+    if (!source.GetData() || source.GetLayout() != TextureLayout::LINEAR || width == 0 || height == 0)
+        return nullptr;
+
+    Entry &entry = Touch(ScaledTextureKey{source.GetId(), width, height, filter, format}, source);
+    if (entry.copy.GetData())
+    {
+        filled = true;
+        return &entry.copy;
+    }
+    if (!WantsCopy(entry))
+        return nullptr;
+    return Allocate(entry, width, height, format);
+}
@@ -0,0 +1,60 @@
+#ifndef SCALEDTEXTURECACHE_H
+#define SCALEDTEXTURECACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include "Texture.h"
+#include "TextureCopyCache.h"
+#include "PixelFormat/PixelFormat.h"
+
+#define SCALED_CACHE_DEFAULT_BUDGET (8u * 1024u * 1024u)
+#define SCALED_CACHE_MAX_ENTRIES 256
+
+namespace Tergos2D
+{
+    struct ScaledTextureKey
+    {
+        uint64_t id;
+        uint32_t width;
+        uint32_t height;
+        uint32_t filter;
+        PixelFormat format;
+
+        bool operator==(const ScaledTextureKey &other) const
+        {
+            return id == other.id && width == other.width && height == other.height &&
+                   filter == other.filter && format == other.format;
+        }
+
+        size_t Hash() const
+        {
+            return std::hash<uint64_t>()(id ^ (static_cast<uint64_t>(width) << 20) ^
+                                         (static_cast<uint64_t>(height) << 40) ^
+                                         (static_cast<uint64_t>(filter) << 56) ^
+                                         (static_cast<uint64_t>(format) << 60));
+        }
+    };
+
+    /// @brief Keeps resampled copies of textures drawn at the same size over and over, e.g. UI elements at a fixed
+    /// density or zoom step. Entries are keyed by texture id, output size, filter and storage format and rebuilt
+    /// when the texture version changes. A copy is made once a key was requested minUses times, copies are dropped
+    /// in LRU order when they exceed the byte budget. Set it on a RenderContext2D to use it for scaled draws.
+    class ScaledTextureCache : public TextureCopyCache<ScaledTextureKey>
+    {
+    public:
+        /// @param budgetBytes bytes of resampled pixels kept at most
+        /// @param minUses requests of the same key before a copy is made, 1 resamples on first use
+        explicit ScaledTextureCache(size_t budgetBytes = SCALED_CACHE_DEFAULT_BUDGET, uint32_t minUses = 2);
+        ~ScaledTextureCache() = default;
+
+        /// @brief Resampled copy of source with the given size, filter (the renderer's sampling method) and format.
+        /// @param filled true if the copy already holds the resampled pixels. false if it was just allocated,
+        /// the caller has to resample into it before the next call
+        /// @return the copy, valid until the next call, or nullptr if the draw has to resample itself
+        Texture *Acquire(const Texture &source, uint32_t width, uint32_t height, uint32_t filter,
+                         PixelFormat format, bool &filled);
+    };
+}
+
+#endif // SCALEDTEXTURECACHE_H
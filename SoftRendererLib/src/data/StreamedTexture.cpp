@@ -0,0 +1,224 @@
+#include "StreamedTexture.h"
+#include "TextureFile.h"
+#include "PixelFormat/PixelFormatInfo.h"
+#include <algorithm>
+
+using namespace Tergos2D;
+
+namespace
+{
+    bool SeekFile(std::FILE *file, uint64_t offset)
+    {
+#if defined(_WIN32)
+        return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#elif ENABLE_ESP_SUPPORT
+        return std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+}
+
+StreamedTexture::~StreamedTexture()
+{
+    Close();
+}
+
+bool StreamedTexture::Open(uint32_t inWidth, uint32_t inHeight, PixelFormat inFormat, TileLoadFunc inLoader, void *userData,
+                           uint32_t inTileSize, size_t budgetBytes)
+{
+    Close();
+    if (inWidth == 0 || inHeight == 0 || inTileSize == 0 || !inLoader)
+        return false;
+
+    width = inWidth;
+    height = inHeight;
+    format = inFormat;
+    loader = inLoader;
+    loaderData = userData;
+    tileSize = inTileSize;
+    tilesX = (width + tileSize - 1) / tileSize;
+    tilesY = (height + tileSize - 1) / tileSize;
+    budget = budgetBytes;
+    return true;
+}
+
+bool StreamedTexture::OpenFile(const char *path, uint64_t offset, uint32_t inWidth, uint32_t inHeight, PixelFormat inFormat,
+                               uint32_t pitch, uint32_t inTileSize, size_t budgetBytes)
+{
+    Close();
+    uint32_t rowBytes = inWidth * PixelFormatRegistry::GetInfo(inFormat).bytesPerPixel;
+    if (pitch == 0)
+        pitch = rowBytes;
+    if (pitch < rowBytes)
+        return false;
+
+    std::FILE *opened = std::fopen(path, "rb");
+    if (!opened)
+        return false;
+
+    if (!Open(inWidth, inHeight, inFormat, LoadFromFile, this, inTileSize, budgetBytes))
+    {
+        std::fclose(opened);
+        return false;
+    }
+    file = opened;
+    fileOffset = offset;
+    filePitch = pitch;
+    return true;
+}
+
+bool StreamedTexture::OpenT2D(const char *path, uint32_t inTileSize, size_t budgetBytes)
+{
+    std::FILE *probe = std::fopen(path, "rb");
+    if (!probe)
+        return false;
+
+    T2DHeader header = {};
+    bool valid = std::fread(&header, sizeof(T2DHeader), 1, probe) == 1;
+    std::fclose(probe);
+    if (!valid || header.magic != T2D_MAGIC || header.version != T2D_VERSION ||
+        header.format >= static_cast<uint32_t>(PixelFormat::COUNT))
+        return false;
+
+    return OpenFile(path, header.dataOffset, header.width, header.height, static_cast<PixelFormat>(header.format),
+                    header.pitch, inTileSize, budgetBytes);
+}
+
+void StreamedTexture::Close()
+{
+    Flush();
+    if (file)
+        std::fclose(file);
+    file = nullptr;
+    loader = nullptr;
+    loaderData = nullptr;
+    width = height = 0;
+    tilesX = tilesY = 0;
+}
+
+bool StreamedTexture::IsOpen() const
+{
+    return loader != nullptr;
+}
+
+uint32_t StreamedTexture::GetWidth() const
+{
+    return width;
+}
+
+uint32_t StreamedTexture::GetHeight() const
+{
+    return height;
+}
+
+PixelFormat StreamedTexture::GetFormat() const
+{
+    return format;
+}
+
+uint32_t StreamedTexture::GetTileSize() const
+{
+    return tileSize;
+}
+
+uint32_t StreamedTexture::GetTilesX() const
+{
+    return tilesX;
+}
+
+uint32_t StreamedTexture::GetTilesY() const
+{
+    return tilesY;
+}
+
+void StreamedTexture::SetBudget(size_t budgetBytes)
+{
+    budget = budgetBytes;
+    Evict(0);
+}
+
+size_t StreamedTexture::GetBudget() const
+{
+    return budget;
+}
+
+size_t StreamedTexture::GetResidentBytes() const
+{
+    return residentBytes;
+}
+
+size_t StreamedTexture::GetResidentTiles() const
+{
+    return lru.size();
+}
+
+Texture *StreamedTexture::GetTile(uint32_t tileX, uint32_t tileY)
+{
+    if (!loader || tileX >= tilesX || tileY >= tilesY)
+        return nullptr;
+
+    uint64_t key = static_cast<uint64_t>(tileY) * tilesX + tileX;
+    auto found = lookup.find(key);
+    if (found != lookup.end())
+    {
+        // move to the front, iterators stay valid
+        lru.splice(lru.begin(), lru, found->second);
+        return &found->second->texture;
+    }
+
+    uint32_t x = tileX * tileSize;
+    uint32_t y = tileY * tileSize;
+    Texture tile(std::min(tileSize, width - x), std::min(tileSize, height - y), format);
+    if (!tile.GetData())
+        return nullptr;
+
+    // load before evicting, a failed load keeps the resident tiles. The new tile itself is always kept
+    if (!loader(x, y, tile, loaderData))
+        return nullptr;
+    Evict(TileBytes(tile));
+
+    residentBytes += TileBytes(tile);
+    lru.push_front(Tile{key, std::move(tile)});
+    lookup[key] = lru.begin();
+    return &lru.front().texture;
+}
+
+void StreamedTexture::Flush()
+{
+    lru.clear();
+    lookup.clear();
+    residentBytes = 0;
+}
+
+void StreamedTexture::Evict(size_t keepBytes)
+{
+    while (!lru.empty() && residentBytes + keepBytes > budget)
+    {
+        residentBytes -= TileBytes(lru.back().texture);
+        lookup.erase(lru.back().key);
+        lru.pop_back();
+    }
+}
+
+size_t StreamedTexture::TileBytes(const Texture &tile)
+{
+    return static_cast<size_t>(tile.GetPitch()) * tile.GetHeight();
+}
+
+bool StreamedTexture::LoadFromFile(uint32_t x, uint32_t y, Texture &tile, void *userData)
+{
+    StreamedTexture *self = static_cast<StreamedTexture *>(userData);
+    uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(self->format).bytesPerPixel;
+    size_t rowBytes = static_cast<size_t>(tile.GetWidth()) * bytesPerPixel;
+
+    for (uint32_t row = 0; row < tile.GetHeight(); ++row)
+    {
+        uint64_t offset = self->fileOffset + static_cast<uint64_t>(y + row) * self->filePitch +
+                          static_cast<uint64_t>(x) * bytesPerPixel;
+        if (!SeekFile(self->file, offset) ||
+            std::fread(tile.GetData() + static_cast<size_t>(row) * tile.GetPitch(), 1, rowBytes, self->file) != rowBytes)
+            return false;
+    }
+    return true;
+}
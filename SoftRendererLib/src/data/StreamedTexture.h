@@ -0,0 +1,101 @@
+#ifndef STREAMEDTEXTURE_H
+#define STREAMEDTEXTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include "Texture.h"
+#include "PixelFormat/PixelFormat.h"
+
+#define STREAM_TILE_SIZE 256
+#define STREAM_DEFAULT_BUDGET (8u * 1024u * 1024u)
+
+namespace Tergos2D
+{
+    /// @brief Fills one tile of a streamed texture
+    /// @param x pixel column of the tile's top left corner in the full image
+    /// @param y pixel row of the tile's top left corner in the full image
+    /// @param tile preallocated texture in the image format, edge tiles are smaller than the tile size
+    /// @return false if the tile could not be loaded, it is skipped when drawing
+    using TileLoadFunc = bool (*)(uint32_t x, uint32_t y, Texture &tile, void *userData);
+
+    /// @brief Image that is split into square tiles which are only loaded when a draw touches them.
+    /// Loaded tiles are kept in LRU order, least recently used tiles are dropped once the
+    /// resident tiles exceed the memory budget. The tile in use is never dropped, and a tile is
+    /// loaded before older ones make room for it, so the budget may be exceeded by one tile.
+    /// Drawn with BasicTextureRenderer, ScaleTextureRenderer and TransformedTextureRenderer (nearest sampling).
+    class StreamedTexture
+    {
+    public:
+        StreamedTexture() = default;
+        ~StreamedTexture();
+
+        StreamedTexture(const StreamedTexture &) = delete;
+        StreamedTexture &operator=(const StreamedTexture &) = delete;
+
+        /// @brief Tiles are produced by a user callback (decoder, network, procedural ...)
+        bool Open(uint32_t width, uint32_t height, PixelFormat format, TileLoadFunc loader, void *userData = nullptr,
+                  uint32_t tileSize = STREAM_TILE_SIZE, size_t budgetBytes = STREAM_DEFAULT_BUDGET);
+        /// @brief Tiles are read from uncompressed rows in a file
+        /// @param offset byte offset of the first row
+        /// @param pitch bytes between rows in the file, 0 for tightly packed rows
+        bool OpenFile(const char *path, uint64_t offset, uint32_t width, uint32_t height, PixelFormat format, uint32_t pitch = 0,
+                      uint32_t tileSize = STREAM_TILE_SIZE, size_t budgetBytes = STREAM_DEFAULT_BUDGET);
+        /// @brief Streams level 0 of a .t2d container through file reads instead of mapping it
+        bool OpenT2D(const char *path, uint32_t tileSize = STREAM_TILE_SIZE, size_t budgetBytes = STREAM_DEFAULT_BUDGET);
+        void Close();
+        bool IsOpen() const;
+
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        PixelFormat GetFormat() const;
+        uint32_t GetTileSize() const;
+        uint32_t GetTilesX() const;
+        uint32_t GetTilesY() const;
+
+        /// @brief Changes the budget, resident tiles above it are dropped right away
+        void SetBudget(size_t budgetBytes);
+        size_t GetBudget() const;
+        size_t GetResidentBytes() const;
+        size_t GetResidentTiles() const;
+
+        /// @brief Resident tile, loaded on demand and marked as most recently used.
+        /// The pointer stays valid until the next call that may load a tile
+        /// @return nullptr if the tile is out of range or failed to load
+        Texture *GetTile(uint32_t tileX, uint32_t tileY);
+        /// @brief Drops all resident tiles
+        void Flush();
+
+    private:
+        struct Tile
+        {
+            uint64_t key;
+            Texture texture;
+        };
+
+        static bool LoadFromFile(uint32_t x, uint32_t y, Texture &tile, void *userData);
+        void Evict(size_t keepBytes);
+        static size_t TileBytes(const Texture &tile);
+
+        TileLoadFunc loader = nullptr;
+        void *loaderData = nullptr;
+
+        std::FILE *file = nullptr;
+        uint64_t fileOffset = 0;
+        uint32_t filePitch = 0;
+
+        uint32_t width = 0, height = 0;
+        PixelFormat format = PixelFormat::RGB24;
+        uint32_t tileSize = STREAM_TILE_SIZE;
+        uint32_t tilesX = 0, tilesY = 0;
+
+        size_t budget = STREAM_DEFAULT_BUDGET;
+        size_t residentBytes = 0;
+        std::list<Tile> lru; // most recently used first
+        std::unordered_map<uint64_t, std::list<Tile>::iterator> lookup;
+    };
+}
+
+#endif // STREAMEDTEXTURE_H
@@ -1,32 +1,68 @@
 #include "Texture.h"
+#include "TextureView.h"
+#include "MipMap.h"
 #include "PixelFormat/PixelFormatInfo.h"
+#include "../util/MemHandler.h"
+#include <algorithm>
+#include <atomic>
 using namespace Tergos2D;
 
-Texture::Texture(uint16_t inWidth, uint16_t inHeight, PixelFormat inFormat, uint16_t inPitch)
-    : pitch(inPitch), width(inWidth), height(inHeight), format(inFormat)
+Texture::Texture(uint32_t inWidth, uint32_t inHeight, PixelFormat inFormat, uint32_t inPitch)
+    : format(inFormat), width(inWidth), height(inHeight), pitch(inPitch)
 {
-    storedLocally = true;
     uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(format).bytesPerPixel;
     if (pitch == 0)
     {
-        this->pitch = width * bytesPerPixel;
+        // pad every row to the alignment so each row starts on an aligned address
+        this->pitch = MemHandler::AlignUp(width * bytesPerPixel, TEXTURE_ROW_ALIGNMENT);
     }
-    data = new uint8_t[width * height * bytesPerPixel];
+    data = static_cast<uint8_t *>(MemHandler::AlignedAlloc(static_cast<size_t>(pitch) * height, TEXTURE_ROW_ALIGNMENT));
+    storage = std::shared_ptr<uint8_t>(data, [](uint8_t *ptr) { MemHandler::AlignedFree(ptr); });
 }
 
-Texture::Texture(uint16_t inWidth, uint16_t inHeight,
-     uint8_t *inData, PixelFormat inFormat, uint16_t inPitch) : pitch(inPitch), width(inWidth), height(inHeight), format(inFormat), data(inData)
+Texture::Texture(uint32_t inWidth, uint32_t inHeight, PixelFormat inFormat, TextureLayout inLayout)
+    : format(inFormat), layout(inLayout), width(inWidth), height(inHeight)
+{
+    uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+    size_t size;
+    if (layout == TextureLayout::TILED)
+    {
+        uint32_t tilesX = (width + TEXTURE_TILE_MASK) >> TEXTURE_TILE_SHIFT;
+        uint32_t tilesY = (height + TEXTURE_TILE_MASK) >> TEXTURE_TILE_SHIFT;
+        pitch = tilesX * TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE * bytesPerPixel;
+        size = static_cast<size_t>(pitch) * tilesY;
+    }
+    else
+    {
+        pitch = MemHandler::AlignUp(width * bytesPerPixel, TEXTURE_ROW_ALIGNMENT);
+        size = static_cast<size_t>(pitch) * height;
+    }
+    data = static_cast<uint8_t *>(MemHandler::AlignedAlloc(size, TEXTURE_ROW_ALIGNMENT));
+    storage = std::shared_ptr<uint8_t>(data, [](uint8_t *ptr) { MemHandler::AlignedFree(ptr); });
+}
+
+Texture::Texture(uint32_t inWidth, uint32_t inHeight,
+     uint8_t *inData, PixelFormat inFormat, uint32_t inPitch) : data(inData), format(inFormat), width(inWidth), height(inHeight), pitch(inPitch)
+{
+    if (pitch == 0)
+    {
+        this->pitch = width * PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+    }
+}
+
+Texture::Texture(uint32_t inWidth, uint32_t inHeight, uint8_t *inData, std::shared_ptr<uint8_t> inStorage,
+     PixelFormat inFormat, uint32_t inPitch)
+    : storage(std::move(inStorage)), data(inData), format(inFormat), width(inWidth), height(inHeight), pitch(inPitch)
 {
     if (pitch == 0)
     {
         this->pitch = width * PixelFormatRegistry::GetInfo(format).bytesPerPixel;
     }
-    storedLocally = false;
 }
 
-Texture::Texture(uint16_t orgWidth, uint16_t orgHeight, uint16_t inWidth, uint16_t inHeight,
-    uint16_t startX, uint16_t startY, uint8_t* inData, PixelFormat inFormat, uint16_t sourcePitch, bool useOrigSize)
-    : format(inFormat), storedLocally(false)
+Texture::Texture(uint32_t orgWidth, uint32_t orgHeight, uint32_t inWidth, uint32_t inHeight,
+    uint32_t startX, uint32_t startY, uint8_t* inData, PixelFormat inFormat, uint32_t sourcePitch, bool useOrigSize)
+    : format(inFormat), isSubTexture(true)
 {
     PixelFormatInfo targetInfo = PixelFormatRegistry::GetInfo(format);
 
@@ -48,38 +84,194 @@ Texture::Texture(uint16_t orgWidth, uint16_t orgHeight, uint16_t inWidth, uint16
     }
 
     // Calculate the offset for the subtexture
-    uint32_t offset = (startY * this->pitch) + (startX * targetInfo.bytesPerPixel);
+    size_t offset = (static_cast<size_t>(startY) * this->pitch) + (static_cast<size_t>(startX) * targetInfo.bytesPerPixel);
     this->data = inData + offset;
 }
 
-Texture::~Texture()
+Texture::Texture(const TextureView &view)
+    : data(view.GetData()), format(view.GetFormat()), isSubTexture(true),
+      width(view.GetWidth()), height(view.GetHeight()), pitch(view.GetPitch())
 {
-    if (storedLocally)
-        delete[] data;
 }
 
+Texture::Texture(Texture &&other) noexcept
+    : storage(std::move(other.storage)), mips(std::move(other.mips)), data(other.data), format(other.format), layout(other.layout), isSubTexture(other.isSubTexture),
+      width(other.width), height(other.height), pitch(other.pitch), id(other.id), version(other.version)
+{
+    other.data = nullptr;
+    other.width = 0;
+    other.height = 0;
+    other.pitch = 0;
+}
+
+Texture &Texture::operator=(Texture &&other) noexcept
+{
+    if (this != &other)
+    {
+        storage = std::move(other.storage);
+        mips = std::move(other.mips);
+        data = other.data;
+        format = other.format;
+        layout = other.layout;
+        isSubTexture = other.isSubTexture;
+        width = other.width;
+        height = other.height;
+        pitch = other.pitch;
+        id = other.id;
+        version = other.version;
+
+        other.data = nullptr;
+        other.width = 0;
+        other.height = 0;
+        other.pitch = 0;
+    }
+    return *this;
+}
 
-uint8_t *Texture::GetData()
+uint8_t *Texture::GetData() const
 {
     return data;
 }
 
-PixelFormat Texture::GetFormat()
+PixelFormat Texture::GetFormat() const
 {
     return format;
 }
 
-uint16_t Texture::GetWidth()
+uint32_t Texture::GetWidth() const
 {
     return width;
 }
 
-uint16_t Texture::GetHeight()
+uint32_t Texture::GetHeight() const
 {
     return height;
 }
 
-uint16_t Texture::GetPitch()
+uint32_t Texture::GetPitch() const
 {
     return pitch;
 }
+
+TextureLayout Texture::GetLayout() const
+{
+    return layout;
+}
+
+PixelAddressing Texture::GetAddressing() const
+{
+    return PixelAddressing{data, pitch, PixelFormatRegistry::GetInfo(format).bytesPerPixel, layout == TextureLayout::TILED};
+}
+
+Texture Texture::ConvertLayout(TextureLayout targetLayout) const
+{
+    if (!data)
+        return Texture();
+
+    Texture converted(width, height, format, targetLayout);
+    PixelAddressing source = GetAddressing();
+    PixelAddressing target = converted.GetAddressing();
+    uint8_t bytesPerPixel = source.bytesPerPixel;
+
+    // copy in runs of at most one tile width, both layouts keep those contiguous
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width;)
+        {
+            uint32_t run = std::min(TEXTURE_TILE_SIZE - (x & TEXTURE_TILE_MASK), width - x);
+            MemHandler::MemCopy(target.At(x, y), source.At(x, y), static_cast<size_t>(run) * bytesPerPixel);
+            x += run;
+        }
+    }
+    return converted;
+}
+
+Texture Texture::SubTexture(uint32_t x, uint32_t y, uint32_t subWidth, uint32_t subHeight) const
+{
+    if (layout != TextureLayout::LINEAR)
+        return Texture();
+    Texture sub(GetView(x, y, subWidth, subHeight));
+    // keep the parent's storage alive for as long as the sub texture exists
+    sub.storage = storage;
+    sub.version = version;
+    return sub;
+}
+
+TextureView Texture::GetView() const
+{
+    if (layout != TextureLayout::LINEAR)
+        return TextureView();
+    return TextureView(data, width, height, format, pitch);
+}
+
+TextureView Texture::GetView(uint32_t x, uint32_t y, uint32_t viewWidth, uint32_t viewHeight) const
+{
+    return GetView().SubView(x, y, viewWidth, viewHeight);
+}
+
+bool Texture::OwnsStorage() const
+{
+    return storage != nullptr;
+}
+
+bool Texture::GenerateMips(MipFilter filter, uint32_t maxLevels)
+{
+    std::vector<Texture> levels = MipMap::BuildChain(*this, filter, maxLevels);
+    if (levels.empty())
+        return false;
+    SetMips(std::move(levels));
+    return true;
+}
+
+void Texture::SetMips(std::vector<Texture> levels)
+{
+    if (levels.empty())
+    {
+        mips.reset();
+        return;
+    }
+    mips = std::make_shared<std::vector<Texture>>(std::move(levels));
+}
+
+void Texture::ClearMips()
+{
+    mips.reset();
+}
+
+uint32_t Texture::GetMipCount() const
+{
+    return mips ? static_cast<uint32_t>(mips->size()) + 1 : 1;
+}
+
+Texture &Texture::GetMip(uint32_t level)
+{
+    if (level == 0 || !mips)
+        return *this;
+    return (*mips)[std::min<size_t>(level, mips->size()) - 1];
+}
+
+uint32_t Texture::SelectMip(float scale) const
+{
+    return MipMap::SelectLevel(scale, GetMipCount());
+}
+
+uint64_t Texture::GetId() const
+{
+    return id;
+}
+
+uint32_t Texture::GetVersion() const
+{
+    return *version;
+}
+
+void Texture::MarkModified()
+{
+    ++*version;
+}
+
+uint64_t Texture::NextId()
+{
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
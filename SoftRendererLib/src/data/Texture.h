@@ -2,40 +2,110 @@
 #define TEXTURE_H
 
 #include <stdint.h>
+#include <memory>
+#include <vector>
 #include "PixelFormat/PixelFormat.h"
+#include "TextureLayout.h"
 
 namespace Tergos2D{
 
+class TextureView;
+
+/// @brief Pixel buffer with format and pitch.
+/// Locally allocated pixel storage is reference counted: copying a Texture shares
+/// the storage, moving transfers it, and the memory is released with the last owner.
+/// Textures created from external data never free it.
 class Texture
 {
 public:
     Texture() = default;
-    Texture(uint16_t width, uint16_t height, PixelFormat format, uint16_t pitch = 0);
-    Texture(uint16_t width, uint16_t height, uint8_t* data,PixelFormat format, uint16_t pitch = 0);
-    Texture(uint16_t orgWidth,uint16_t orgHeight,uint16_t width, uint16_t height, uint16_t startX, uint16_t startY, uint8_t* data, PixelFormat format, uint16_t pitch = 0, bool useOrigSize= false);
-    ~Texture();
+    /// @brief Allocates the pixel data through MemHandler, rows start 64 byte aligned.
+    /// With pitch = 0 the pitch is padded to a multiple of TEXTURE_ROW_ALIGNMENT
+    Texture(uint32_t width, uint32_t height, PixelFormat format, uint32_t pitch = 0);
+    /// @brief Allocates storage in the given layout, tiled textures are padded to whole tiles
+    Texture(uint32_t width, uint32_t height, PixelFormat format, TextureLayout layout);
+    Texture(uint32_t width, uint32_t height, uint8_t* data,PixelFormat format, uint32_t pitch = 0);
+    Texture(uint32_t orgWidth,uint32_t orgHeight,uint32_t width, uint32_t height, uint32_t startX, uint32_t startY, uint8_t* data, PixelFormat format, uint32_t pitch = 0, bool useOrigSize= false);
+    /// @brief Wraps external pixels whose lifetime is tied to storage, e.g. a memory mapped file.
+    /// The texture keeps storage alive, data has to point into it
+    Texture(uint32_t width, uint32_t height, uint8_t* data, std::shared_ptr<uint8_t> storage, PixelFormat format, uint32_t pitch = 0);
+    /// @brief Wraps the pixels of a view without copying, the view's memory has to outlive the texture
+    explicit Texture(const TextureView& view);
+    ~Texture() = default;
+
+    Texture(const Texture& other) = default;
+    Texture& operator=(const Texture& other) = default;
+    Texture(Texture&& other) noexcept;
+    Texture& operator=(Texture&& other) noexcept;
 
     /// @brief Get Pointer of Texture
     /// @return uint8_t*
-    uint8_t* GetData();
+    uint8_t* GetData() const;
 
 
     /// @brief Get Format of Texture
     /// @return PixelFormat
-    PixelFormat GetFormat();
+    PixelFormat GetFormat() const;
+
+
+    uint32_t GetPitch() const;
+    uint32_t GetWidth() const;
+    uint32_t GetHeight() const;
+
+    TextureLayout GetLayout() const;
+    /// @brief Addressing helper for the current layout
+    PixelAddressing GetAddressing() const;
 
+    /// @brief Copies the pixels into a newly allocated texture with the requested layout
+    Texture ConvertLayout(TextureLayout layout) const;
 
-    uint16_t GetPitch();
-    uint16_t GetWidth();
-    uint16_t GetHeight();
+    /// @brief Returns a texture for the given region that shares this texture's storage.
+    /// The region is clamped to the texture bounds, no pixels are copied. Linear layout only
+    Texture SubTexture(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    /// @brief Non owning view of the whole texture, empty for tiled textures
+    TextureView GetView() const;
+    /// @brief Non owning view of a region, clamped to the texture bounds, empty for tiled textures
+    TextureView GetView(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    /// @brief Builds and attaches a mip chain (see MipMap::BuildChain), replacing an existing one.
+    /// Copies of the texture share the chain
+    /// @return false if no levels could be built
+    bool GenerateMips(MipFilter filter = MipFilter::BOX, uint32_t maxLevels = 0);
+    /// @brief Attaches prebuilt levels 1..n, e.g. the levels stored in a .t2d file
+    void SetMips(std::vector<Texture> levels);
+    void ClearMips();
+    /// @brief Number of levels including the texture itself
+    uint32_t GetMipCount() const;
+    /// @brief Level 0 is the texture itself, levels past the end return the smallest level
+    Texture &GetMip(uint32_t level);
+    /// @brief Level closest to the drawn size without being smaller, scale relative to this texture
+    uint32_t SelectMip(float scale) const;
+
+    /// @brief Unique per allocation or wrapped region, copies keep the id since they share the pixels
+    uint64_t GetId() const;
+    /// @brief Counter for caches holding derived data (e.g. ConvertedTextureCache), shared by copies and sub textures.
+    /// Draws through a RenderContext2D bump it for their target, bump it after changing the pixels directly
+    uint32_t GetVersion() const;
+    void MarkModified();
+
+    /// @brief True if the pixel data is allocated and owned (possibly shared) by this texture
+    bool OwnsStorage() const;
 
 private:
-    uint8_t* data;
-    PixelFormat format;
+    std::shared_ptr<uint8_t> storage;
+    std::shared_ptr<std::vector<Texture>> mips;
+    uint8_t* data = nullptr;
+    PixelFormat format = PixelFormat::RGB24;
+    TextureLayout layout = TextureLayout::LINEAR;
     bool isSubTexture = false;
-    bool storedLocally = false;
-    uint16_t width, height;
-    uint16_t pitch = 0;
+    uint32_t width = 0, height = 0;
+    uint32_t pitch = 0;
+    uint64_t id = NextId();
+    // shared like the pixels, a change made through one copy invalidates derived data of all of them
+    std::shared_ptr<uint32_t> version = std::make_shared<uint32_t>(0);
+
+    static uint64_t NextId();
 };
 
 }
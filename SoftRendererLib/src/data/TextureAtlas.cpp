@@ -0,0 +1,219 @@
+#include "TextureAtlas.h"
+#include "PixelFormat/PixelFormatInfo.h"
+#include "PixelFormat/PixelConverter.h"
+#include "../util/MemHandler.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Tergos2D;
+
+TextureAtlas::TextureAtlas(uint32_t inPageWidth, uint32_t inPageHeight, PixelFormat inFormat, uint32_t inPadding)
+    : pageWidth(inPageWidth), pageHeight(inPageHeight), format(inFormat), padding(inPadding)
+{
+}
+
+size_t TextureAtlas::Add(const Texture &texture)
+{
+    Entry entry;
+    // packing copies rows, tiled textures are brought back to linear first
+    entry.source = texture.GetLayout() == TextureLayout::LINEAR ? texture : texture.ConvertLayout(TextureLayout::LINEAR);
+    entry.region.width = texture.GetWidth();
+    entry.region.height = texture.GetHeight();
+    entries.push_back(entry);
+    return entries.size() - 1;
+}
+
+bool TextureAtlas::Pack()
+{
+    // tallest first keeps the skyline flat, ties broken by width
+    std::vector<size_t> order;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (!entries[i].region.packed)
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+                     {
+                         const AtlasRegion &ra = entries[a].region;
+                         const AtlasRegion &rb = entries[b].region;
+                         if (ra.height != rb.height)
+                             return ra.height > rb.height;
+                         return ra.width > rb.width; });
+
+    bool allPacked = true;
+    for (size_t index : order)
+    {
+        Entry &entry = entries[index];
+        uint32_t paddedWidth = entry.region.width + 2 * padding;
+        uint32_t paddedHeight = entry.region.height + 2 * padding;
+        if (paddedWidth > pageWidth || paddedHeight > pageHeight || entry.source.GetData() == nullptr ||
+            !PixelConverter::GetConversionFunction(entry.source.GetFormat(), format))
+        {
+            allPacked = false;
+            continue;
+        }
+
+        // search existing pages first, then open a new one
+        bool placed = false;
+        for (size_t p = 0; p <= pages.size() && !placed; ++p)
+        {
+            Page &page = (p == pages.size()) ? AddPage() : pages[p];
+            uint32_t x, y;
+            size_t node;
+            if (!FindPosition(page, paddedWidth, paddedHeight, x, y, node))
+                continue;
+
+            AddSkylineLevel(page, node, x, y, paddedWidth, paddedHeight);
+            entry.region.page = static_cast<uint32_t>(p);
+            entry.region.x = x + padding;
+            entry.region.y = y + padding;
+            placed = CopyInto(entry, page);
+        }
+
+        entry.region.packed = placed;
+        if (placed)
+            entry.source = Texture(); // release the source, the pixels now live in the page
+        else
+            allPacked = false;
+    }
+    return allPacked;
+}
+
+Texture TextureAtlas::GetTexture(size_t id) const
+{
+    const AtlasRegion &region = entries[id].region;
+    if (!region.packed)
+        return Texture();
+    return pages[region.page].texture.SubTexture(region.x, region.y, region.width, region.height);
+}
+
+const AtlasRegion &TextureAtlas::GetRegion(size_t id) const
+{
+    return entries[id].region;
+}
+
+size_t TextureAtlas::GetEntryCount() const
+{
+    return entries.size();
+}
+
+size_t TextureAtlas::GetPageCount() const
+{
+    return pages.size();
+}
+
+Texture &TextureAtlas::GetPage(size_t page)
+{
+    return pages[page].texture;
+}
+
+bool TextureAtlas::FindPosition(const Page &page, uint32_t width, uint32_t height, uint32_t &outX, uint32_t &outY, size_t &outNode) const
+{
+    uint32_t bestY = UINT32_MAX;
+    uint32_t bestWidth = UINT32_MAX;
+    bool found = false;
+
+    for (size_t i = 0; i < page.skyline.size(); ++i)
+    {
+        uint32_t x = page.skyline[i].x;
+        if (x + width > pageWidth)
+            break;
+
+        // the rect rests on the highest node it spans
+        uint32_t y = 0;
+        uint32_t widthLeft = width;
+        size_t j = i;
+        while (widthLeft > 0)
+        {
+            y = std::max(y, page.skyline[j].y);
+            uint32_t used = std::min(widthLeft, page.skyline[j].width);
+            widthLeft -= used;
+            ++j;
+        }
+        if (y + height > pageHeight)
+            continue;
+
+        // bottom-left: lowest position wins, narrower node on ties wastes less
+        if (y < bestY || (y == bestY && page.skyline[i].width < bestWidth))
+        {
+            bestY = y;
+            bestWidth = page.skyline[i].width;
+            outX = x;
+            outY = y;
+            outNode = i;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void TextureAtlas::AddSkylineLevel(Page &page, size_t nodeIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    std::vector<SkylineNode> &skyline = page.skyline;
+    skyline.insert(skyline.begin() + nodeIndex, SkylineNode{x, y + height, width});
+
+    // shrink or drop the nodes now covered by the new level
+    for (size_t i = nodeIndex + 1; i < skyline.size();)
+    {
+        SkylineNode &previous = skyline[i - 1];
+        SkylineNode &node = skyline[i];
+        if (node.x >= previous.x + previous.width)
+            break;
+
+        uint32_t shrink = previous.x + previous.width - node.x;
+        if (node.width <= shrink)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        node.x += shrink;
+        node.width -= shrink;
+        break;
+    }
+
+    // merge neighbours on the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+TextureAtlas::Page &TextureAtlas::AddPage()
+{
+    Page page;
+    page.texture = Texture(pageWidth, pageHeight, format);
+    // padding and unused space stay fully transparent
+    std::memset(page.texture.GetData(), 0, static_cast<size_t>(page.texture.GetPitch()) * pageHeight);
+    page.skyline.push_back(SkylineNode{0, 0, pageWidth});
+    pages.push_back(std::move(page));
+    return pages.back();
+}
+
+bool TextureAtlas::CopyInto(const Entry &entry, Page &page)
+{
+    const Texture &source = entry.source;
+    PixelConverter::ConvertFunc convertFunc = PixelConverter::GetConversionFunction(source.GetFormat(), format);
+    if (!convertFunc)
+        return false;
+
+    uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+    size_t targetPitch = page.texture.GetPitch();
+    uint8_t *targetRow = page.texture.GetData() + entry.region.y * targetPitch + static_cast<size_t>(entry.region.x) * bytesPerPixel;
+    const uint8_t *sourceRow = source.GetData();
+
+    for (uint32_t y = 0; y < entry.region.height; ++y)
+    {
+        convertFunc(sourceRow, targetRow, entry.region.width);
+        sourceRow += source.GetPitch();
+        targetRow += targetPitch;
+    }
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Texture.h"
+#include "PixelFormat/PixelFormat.h"
+
+namespace Tergos2D
+{
+    /// @brief Placement of one packed texture inside the atlas
+    struct AtlasRegion
+    {
+        uint32_t page = 0;
+        uint32_t x = 0, y = 0;
+        uint32_t width = 0, height = 0;
+        bool packed = false;
+    };
+
+    /// @brief Packs many small textures into one or more large pages at load time.
+    /// Uses skyline bottom-left bin packing, textures are inserted tallest first.
+    /// Pixels are converted into the page format while copying.
+    class TextureAtlas
+    {
+    public:
+        /// @param pageWidth width of every atlas page
+        /// @param pageHeight height of every atlas page
+        /// @param format pixel format of the pages
+        /// @param padding empty pixels kept around every entry, avoids bleeding when sampling
+        TextureAtlas(uint32_t pageWidth, uint32_t pageHeight, PixelFormat format, uint32_t padding = 1);
+        ~TextureAtlas() = default;
+
+        /// @brief Queue a texture for packing. Texture storage is shared, external data has to stay valid until Pack
+        /// @return id used with GetTexture / GetRegion
+        size_t Add(const Texture &texture);
+
+        /// @brief Packs all queued textures, opening new pages when needed
+        /// @return false if any texture could not be placed (too large or no pixel conversion)
+        bool Pack();
+
+        /// @brief Sub texture of the packed entry, shares the page storage.
+        /// Returns an empty texture if the entry was not packed
+        Texture GetTexture(size_t id) const;
+        const AtlasRegion &GetRegion(size_t id) const;
+
+        size_t GetEntryCount() const;
+        size_t GetPageCount() const;
+        Texture &GetPage(size_t page);
+
+    private:
+        struct SkylineNode
+        {
+            uint32_t x, y, width;
+        };
+
+        struct Page
+        {
+            Texture texture;
+            std::vector<SkylineNode> skyline;
+        };
+
+        struct Entry
+        {
+            Texture source;
+            AtlasRegion region;
+        };
+
+        bool FindPosition(const Page &page, uint32_t width, uint32_t height, uint32_t &outX, uint32_t &outY, size_t &outNode) const;
+        void AddSkylineLevel(Page &page, size_t nodeIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+        Page &AddPage();
+        bool CopyInto(const Entry &entry, Page &page);
+
+        uint32_t pageWidth, pageHeight;
+        PixelFormat format;
+        uint32_t padding;
+        std::vector<Page> pages;
+        std::vector<Entry> entries;
+    };
+}
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,171 @@
+#ifndef TEXTURECOPYCACHE_H
+#define TEXTURECOPYCACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include "Texture.h"
+#include "PixelFormat/PixelFormat.h"
+#include "PixelFormat/PixelFormatInfo.h"
+#include "../util/MemHandler.h"
+
+namespace Tergos2D
+{
+    /// @brief Budgeted LRU store of copies derived from textures, the common part of ConvertedTextureCache and
+    /// ScaledTextureCache. Entries are tracked per Key, which holds the source texture id and whatever else
+    /// distinguishes its copies, and provides operator== and Hash(). A copy is made once a key was requested
+    /// minUses times and dropped when the source version changes. Copies are released in LRU order when they
+    /// exceed the byte budget, entries without a copy are bounded by maxEntries.
+    template <typename Key>
+    class TextureCopyCache
+    {
+    public:
+        TextureCopyCache(size_t budgetBytes, uint32_t inMinUses, size_t inMaxEntries)
+            : budget(budgetBytes), minUses(std::max(inMinUses, 1u)), maxEntries(inMaxEntries)
+        {
+        }
+        ~TextureCopyCache() = default;
+
+        TextureCopyCache(const TextureCopyCache &) = delete;
+        TextureCopyCache &operator=(const TextureCopyCache &) = delete;
+
+        /// @brief Drops every copy made from the texture
+        void Invalidate(const Texture &source)
+        {
+            for (auto it = lru.begin(); it != lru.end();)
+            {
+                auto next = std::next(it);
+                if (it->key.id == source.GetId())
+                    Erase(it);
+                it = next;
+            }
+        }
+
+        void Clear()
+        {
+            lru.clear();
+            lookup.clear();
+            residentBytes = 0;
+        }
+
+        void SetBudget(size_t budgetBytes)
+        {
+            budget = budgetBytes;
+            Evict(0, nullptr);
+        }
+
+        size_t GetBudget() const { return budget; }
+        size_t GetResidentBytes() const { return residentBytes; }
+        size_t GetEntryCount() const { return lru.size(); }
+
+    protected:
+        struct Entry
+        {
+            Key key;
+            uint32_t version;
+            uint32_t uses;
+            Texture copy;
+        };
+
+        /// @brief Counts a request of key, made most recently used. The copy is dropped if source changed since it was made
+        Entry &Touch(const Key &key, const Texture &source)
+        {
+            auto found = lookup.find(key);
+            if (found == lookup.end())
+            {
+                lru.push_front(Entry{key, source.GetVersion(), 0, Texture()});
+                lookup[key] = lru.begin();
+                // tracking entries without a copy are bounded by count
+                if (lru.size() > maxEntries)
+                    Erase(std::prev(lru.end()));
+            }
+            else
+            {
+                lru.splice(lru.begin(), lru, found->second);
+            }
+
+            Entry &entry = lru.front();
+            if (entry.version != source.GetVersion())
+            {
+                residentBytes -= Bytes(entry.copy);
+                entry.copy = Texture();
+                entry.version = source.GetVersion();
+                entry.uses = 0;
+            }
+            entry.uses++;
+            return entry;
+        }
+
+        /// @brief True once the entry was requested often enough to get a copy
+        bool WantsCopy(const Entry &entry) const
+        {
+            return entry.uses >= minUses;
+        }
+
+        /// @brief Allocates the entry's copy, evicting older copies to stay within the budget.
+        /// The pixels are left for the caller to fill
+        /// @return nullptr if the copy alone exceeds the budget or the allocation fails
+        Texture *Allocate(Entry &entry, uint32_t width, uint32_t height, PixelFormat format)
+        {
+            size_t pitch = MemHandler::AlignUp(static_cast<size_t>(width) * PixelFormatRegistry::GetInfo(format).bytesPerPixel,
+                                               TEXTURE_ROW_ALIGNMENT);
+            if (pitch * height > budget)
+                return nullptr;
+            Evict(pitch * height, &entry);
+
+            Texture copy(width, height, format);
+            if (!copy.GetData())
+                return nullptr;
+            residentBytes += Bytes(copy);
+            entry.copy = std::move(copy);
+            return &entry.copy;
+        }
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(const Key &key) const
+            {
+                return key.Hash();
+            }
+        };
+
+        void Evict(size_t requiredBytes, const Entry *keep)
+        {
+            auto it = lru.end();
+            while (residentBytes + requiredBytes > budget && it != lru.begin())
+            {
+                --it;
+                if (&*it == keep || !it->copy.GetData())
+                    continue;
+                residentBytes -= Bytes(it->copy);
+                it->copy = Texture();
+                it->uses = 0;
+            }
+        }
+
+        void Erase(typename std::list<Entry>::iterator entry)
+        {
+            residentBytes -= Bytes(entry->copy);
+            lookup.erase(entry->key);
+            lru.erase(entry);
+        }
+
+        static size_t Bytes(const Texture &texture)
+        {
+            return texture.GetData() ? static_cast<size_t>(texture.GetPitch()) * texture.GetHeight() : 0;
+        }
+
+        std::list<Entry> lru; // most recently used first
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> lookup;
+        size_t budget;
+        size_t residentBytes = 0;
+        uint32_t minUses;
+        size_t maxEntries;
+    };
+}
+
+#endif // TEXTURECOPYCACHE_H
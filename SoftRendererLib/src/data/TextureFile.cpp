@@ -0,0 +1,233 @@
+#include "TextureFile.h"
+#include "PixelFormat/PixelFormatInfo.h"
+#include "../util/MemHandler.h"
+#include <cstring>
+#include <cstdio>
+
+#if defined(_WIN32) || ENABLE_ESP_SUPPORT
+#define T2D_USE_MMAP 0
+#else
+#define T2D_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace Tergos2D;
+
+bool TextureFile::Open(const char *path)
+{
+    Close();
+
+#if T2D_USE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(T2DHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    // private mapping: pages are shared with the page cache, accidental writes never reach the file
+    void *mapped = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    storage = std::shared_ptr<uint8_t>(static_cast<uint8_t *>(mapped), [fileSize](uint8_t *ptr)
+                                       { munmap(ptr, fileSize); });
+#else
+    FILE *file = std::fopen(path, "rb");
+    if (!file)
+        return false;
+
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (length < static_cast<long>(sizeof(T2DHeader)))
+    {
+        std::fclose(file);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(length);
+    uint8_t *buffer = static_cast<uint8_t *>(MemHandler::AlignedAlloc(fileSize, TEXTURE_ROW_ALIGNMENT));
+    if (!buffer)
+    {
+        std::fclose(file);
+        return false;
+    }
+    storage = std::shared_ptr<uint8_t>(buffer, [](uint8_t *ptr)
+                                       { MemHandler::AlignedFree(ptr); });
+    size_t read = std::fread(buffer, 1, fileSize, file);
+    std::fclose(file);
+    if (read != fileSize)
+    {
+        Close();
+        return false;
+    }
+#endif
+
+    base = storage.get();
+    size = fileSize;
+    if (!Validate())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool TextureFile::OpenMemory(uint8_t *data, size_t dataSize)
+{
+    Close();
+    if (!data || dataSize < sizeof(T2DHeader))
+        return false;
+
+    base = data;
+    size = dataSize;
+    if (!Validate())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void TextureFile::Close()
+{
+    storage.reset();
+    base = nullptr;
+    size = 0;
+    header = {};
+}
+
+bool TextureFile::IsOpen() const
+{
+    return base != nullptr;
+}
+
+const T2DHeader &TextureFile::GetHeader() const
+{
+    return header;
+}
+
+PixelFormat TextureFile::GetFormat() const
+{
+    return static_cast<PixelFormat>(header.format);
+}
+
+uint32_t TextureFile::GetLevelCount() const
+{
+    return IsOpen() ? header.mipCount + 1 : 0;
+}
+
+Texture TextureFile::GetTexture(uint32_t level) const
+{
+    T2DMipLevel info;
+    if (!ReadLevel(level, info))
+        return Texture();
+
+    return Texture(info.width, info.height, base + info.offset, storage, GetFormat(), info.pitch);
+}
+
+Texture TextureFile::GetTextureWithMips() const
+{
+    Texture texture = GetTexture(0);
+    std::vector<Texture> levels;
+    for (uint32_t level = 1; level < GetLevelCount(); ++level)
+    {
+        Texture mip = GetTexture(level);
+        if (!mip.GetData())
+            break;
+        levels.push_back(std::move(mip));
+    }
+    texture.SetMips(std::move(levels));
+    return texture;
+}
+
+uint32_t TextureFile::GetAtlasEntryCount() const
+{
+    return header.atlasCount;
+}
+
+T2DAtlasEntry TextureFile::GetAtlasEntry(uint32_t index) const
+{
+    T2DAtlasEntry entry = {};
+    if (index < header.atlasCount)
+        std::memcpy(&entry, base + header.atlasTableOffset + index * sizeof(T2DAtlasEntry), sizeof(T2DAtlasEntry));
+    return entry;
+}
+
+Texture TextureFile::GetAtlasTexture(uint32_t index) const
+{
+    if (index >= header.atlasCount)
+        return Texture();
+
+    T2DAtlasEntry entry = GetAtlasEntry(index);
+    return GetTexture(0).SubTexture(entry.x, entry.y, entry.width, entry.height);
+}
+
+bool TextureFile::Validate()
+{
+    // the mapping may not be aligned for T2DHeader, copy it out
+    std::memcpy(&header, base, sizeof(T2DHeader));
+
+    if (header.magic != T2D_MAGIC || header.version != T2D_VERSION || header.headerSize < sizeof(T2DHeader))
+        return false;
+    if (header.format >= static_cast<uint32_t>(PixelFormat::COUNT))
+        return false;
+    if (!RangeInFile(header.mipTableOffset, static_cast<uint64_t>(header.mipCount) * sizeof(T2DMipLevel)))
+        return false;
+    if (!RangeInFile(header.atlasTableOffset, static_cast<uint64_t>(header.atlasCount) * sizeof(T2DAtlasEntry)))
+        return false;
+
+    for (uint32_t level = 0; level <= header.mipCount; ++level)
+    {
+        T2DMipLevel info;
+        if (!ReadLevel(level, info))
+            return false;
+    }
+
+    for (uint32_t i = 0; i < header.atlasCount; ++i)
+    {
+        T2DAtlasEntry entry = GetAtlasEntry(i);
+        if (static_cast<uint64_t>(entry.x) + entry.width > header.width ||
+            static_cast<uint64_t>(entry.y) + entry.height > header.height)
+            return false;
+    }
+    return true;
+}
+
+bool TextureFile::ReadLevel(uint32_t level, T2DMipLevel &outLevel) const
+{
+    if (!IsOpen() || level > header.mipCount)
+        return false;
+
+    if (level == 0)
+    {
+        outLevel = {header.width, header.height, header.pitch, 0, header.dataOffset};
+    }
+    else
+    {
+        std::memcpy(&outLevel, base + header.mipTableOffset + (level - 1) * sizeof(T2DMipLevel), sizeof(T2DMipLevel));
+    }
+
+    uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(GetFormat()).bytesPerPixel;
+    if (outLevel.width == 0 || outLevel.height == 0 || outLevel.pitch < static_cast<uint64_t>(outLevel.width) * bytesPerPixel)
+        return false;
+
+    // the last row only needs its pixels, not the full pitch
+    uint64_t length = static_cast<uint64_t>(outLevel.pitch) * (outLevel.height - 1) + static_cast<uint64_t>(outLevel.width) * bytesPerPixel;
+    return RangeInFile(outLevel.offset, length);
+}
+
+bool TextureFile::RangeInFile(uint64_t offset, uint64_t length) const
+{
+    return offset <= size && length <= size - offset;
+}
@@ -0,0 +1,99 @@
+#ifndef TEXTUREFILE_H
+#define TEXTUREFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include "Texture.h"
+
+// "T2D1" read as little endian uint32
+#define T2D_MAGIC 0x31443254u
+#define T2D_VERSION 1
+
+namespace Tergos2D
+{
+    /// @brief On disk header of a .t2d texture container, all fields little endian.
+    /// Pixel data is stored exactly like a Texture in memory, so the file can be mapped and drawn directly.
+    struct T2DHeader
+    {
+        uint32_t magic;            // T2D_MAGIC
+        uint16_t version;          // T2D_VERSION
+        uint16_t headerSize;       // sizeof(T2DHeader), allows appending fields later
+        uint32_t format;           // PixelFormat of all levels
+        uint32_t width;            // level 0
+        uint32_t height;
+        uint32_t pitch;
+        uint32_t alignment;        // alignment of pitch and data offsets chosen by the packer
+        uint32_t mipCount;         // number of additional mip levels in the mip table
+        uint32_t atlasCount;       // number of entries in the atlas table
+        uint32_t reserved;
+        uint64_t dataOffset;       // level 0 pixels, from the start of the file
+        uint64_t mipTableOffset;   // T2DMipLevel[mipCount], level 1 first
+        uint64_t atlasTableOffset; // T2DAtlasEntry[atlasCount], rectangles in level 0
+    };
+    static_assert(sizeof(T2DHeader) == 64, "T2DHeader layout changed");
+
+    struct T2DMipLevel
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t pitch;
+        uint32_t reserved;
+        uint64_t offset;
+    };
+    static_assert(sizeof(T2DMipLevel) == 24, "T2DMipLevel layout changed");
+
+    struct T2DAtlasEntry
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+    static_assert(sizeof(T2DAtlasEntry) == 16, "T2DAtlasEntry layout changed");
+
+    /// @brief Loads .t2d containers without decoding or copying pixels.
+    /// On POSIX systems the file is memory mapped (private, copy on write), elsewhere it is read
+    /// into one aligned allocation. Textures handed out keep the mapping alive on their own.
+    class TextureFile
+    {
+    public:
+        TextureFile() = default;
+        ~TextureFile() = default;
+
+        /// @brief Map and validate a file
+        /// @return false if the file can not be opened or is not a valid container
+        bool Open(const char *path);
+        /// @brief Use a container that is already in memory (e.g. linked into flash), the memory is not owned
+        bool OpenMemory(uint8_t *data, size_t size);
+        void Close();
+        bool IsOpen() const;
+
+        const T2DHeader &GetHeader() const;
+        PixelFormat GetFormat() const;
+
+        /// @brief Number of levels including level 0
+        uint32_t GetLevelCount() const;
+        /// @brief Zero-copy texture of a mip level, empty texture if level is out of range
+        Texture GetTexture(uint32_t level = 0) const;
+        /// @brief Zero-copy level 0 with the stored lower levels attached as its mip chain
+        Texture GetTextureWithMips() const;
+
+        uint32_t GetAtlasEntryCount() const;
+        T2DAtlasEntry GetAtlasEntry(uint32_t index) const;
+        /// @brief Zero-copy sub texture of level 0 for an atlas entry
+        Texture GetAtlasTexture(uint32_t index) const;
+
+    private:
+        bool Validate();
+        bool ReadLevel(uint32_t level, T2DMipLevel &outLevel) const;
+        bool RangeInFile(uint64_t offset, uint64_t length) const;
+
+        std::shared_ptr<uint8_t> storage;
+        uint8_t *base = nullptr;
+        size_t size = 0;
+        T2DHeader header = {};
+    };
+}
+
+#endif // TEXTUREFILE_H
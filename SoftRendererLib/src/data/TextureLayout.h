@@ -0,0 +1,48 @@
+#ifndef TEXTURELAYOUT_H
+#define TEXTURELAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// tiles are TEXTURE_TILE_SIZE x TEXTURE_TILE_SIZE pixels, 256 bytes for 32 bit formats
+#define TEXTURE_TILE_SHIFT 3
+#define TEXTURE_TILE_SIZE (1u << TEXTURE_TILE_SHIFT)
+#define TEXTURE_TILE_MASK (TEXTURE_TILE_SIZE - 1u)
+
+namespace Tergos2D
+{
+    enum class TextureLayout
+    {
+        LINEAR, // rows stored one after another, pitch bytes apart
+        TILED   // 8x8 tiles stored contiguously (rows inside a tile), pitch is the size of one row of tiles
+    };
+
+    /// @brief Filter used to build mip levels, see MipMap
+    enum class MipFilter
+    {
+        BOX,  // 2x2 average
+        TENT  // 4x4 footprint with 1 3 3 1 weights, softer but less aliasing
+    };
+
+    /// @brief Resolves pixel coordinates to addresses for either layout.
+    /// Renderers set it up once per draw, the layout branch is loop invariant
+    struct PixelAddressing
+    {
+        uint8_t *data;
+        size_t pitch;
+        uint8_t bytesPerPixel;
+        bool tiled;
+
+        inline uint8_t *At(uint32_t x, uint32_t y) const
+        {
+            if (!tiled)
+                return data + static_cast<size_t>(y) * pitch + static_cast<size_t>(x) * bytesPerPixel;
+
+            size_t tileOffset = static_cast<size_t>(x >> TEXTURE_TILE_SHIFT) << (2 * TEXTURE_TILE_SHIFT);
+            size_t inTile = ((y & TEXTURE_TILE_MASK) << TEXTURE_TILE_SHIFT) | (x & TEXTURE_TILE_MASK);
+            return data + static_cast<size_t>(y >> TEXTURE_TILE_SHIFT) * pitch + (tileOffset + inTile) * bytesPerPixel;
+        }
+    };
+}
+
+#endif // TEXTURELAYOUT_H
@@ -0,0 +1,58 @@
+#ifndef TEXTUREVIEW_H
+#define TEXTUREVIEW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include "PixelFormat/PixelFormat.h"
+#include "PixelFormat/PixelFormatInfo.h"
+
+namespace Tergos2D
+{
+    /// @brief Cheap non owning window into pixel memory.
+    /// Does not keep the memory alive, hold on to the owning Texture while the view is in use.
+    class TextureView
+    {
+    public:
+        TextureView() = default;
+        TextureView(uint8_t *data, uint32_t width, uint32_t height, PixelFormat format, uint32_t pitch = 0)
+            : data(data), format(format), width(width), height(height), pitch(pitch)
+        {
+            if (this->pitch == 0)
+                this->pitch = width * PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+        }
+
+        uint8_t *GetData() const { return data; }
+        PixelFormat GetFormat() const { return format; }
+        uint32_t GetWidth() const { return width; }
+        uint32_t GetHeight() const { return height; }
+        uint32_t GetPitch() const { return pitch; }
+        bool IsEmpty() const { return data == nullptr || width == 0 || height == 0; }
+
+        /// @brief Pointer to the first pixel of row y
+        uint8_t *GetRow(uint32_t y) const
+        {
+            return data + static_cast<size_t>(y) * pitch;
+        }
+
+        /// @brief View of a region of this view, clamped to its bounds
+        TextureView SubView(uint32_t x, uint32_t y, uint32_t subWidth, uint32_t subHeight) const
+        {
+            if (x >= width || y >= height)
+                return TextureView(nullptr, 0, 0, format, pitch);
+
+            subWidth = std::min(subWidth, width - x);
+            subHeight = std::min(subHeight, height - y);
+            uint8_t bytesPerPixel = PixelFormatRegistry::GetInfo(format).bytesPerPixel;
+            return TextureView(GetRow(y) + static_cast<size_t>(x) * bytesPerPixel, subWidth, subHeight, format, pitch);
+        }
+
+    private:
+        uint8_t *data = nullptr;
+        PixelFormat format = PixelFormat::RGB24;
+        uint32_t width = 0, height = 0;
+        uint32_t pitch = 0;
+    };
+}
+
+#endif // TEXTUREVIEW_H
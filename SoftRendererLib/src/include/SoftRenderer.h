@@ -3,6 +3,17 @@
 
 #include "../core/RenderContext2D.h"
 #include "../data/Texture.h"
+#include "../data/TextureLayout.h"
+#include "../data/MipMap.h"
+#include "../data/TextureView.h"
+#include "../data/TextureAtlas.h"
+#include "../data/RenderTargetPool.h"
+#include "../data/ConvertedTextureCache.h"
+#include "../data/ScaledTextureCache.h"
+#include "../data/TextureFile.h"
+#include "../data/StreamedTexture.h"
+#include "../data/RLETexture.h"
+#include "../data/BlockTexture.h"
 #include "../data/Color.h"
 #include "../data/PixelFormat/PixelFormat.h"
 #include "../core/Renderers/BasicTextureRenderer.h"
@@ -1,5 +1,69 @@
 #include "MemHandler.h"
 #include <memory>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <malloc.h>
+#elif ENABLE_ESP_SUPPORT
+#include "esp_heap_caps.h"
+#endif
 
 using namespace Tergos2D;
 
+namespace
+{
+    void *DefaultAlloc(size_t size, size_t alignment, void *)
+    {
+#if defined(_WIN32)
+        // MSVC has no aligned_alloc, its aligned blocks have to be released with _aligned_free
+        return _aligned_malloc(size, alignment);
+#elif ENABLE_ESP_SUPPORT
+        return heap_caps_aligned_alloc(alignment, size, MALLOC_CAP_DEFAULT);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        return std::aligned_alloc(alignment, MemHandler::AlignUp(size, alignment));
+#endif
+    }
+
+    void DefaultFree(void *ptr, void *)
+    {
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#elif ENABLE_ESP_SUPPORT
+        heap_caps_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+AllocFunc MemHandler::allocFunc = DefaultAlloc;
+FreeFunc MemHandler::freeFunc = DefaultFree;
+void *MemHandler::allocUserData = nullptr;
+
+void MemHandler::SetAllocator(AllocFunc alloc, FreeFunc free, void *userData)
+{
+    if (alloc == nullptr || free == nullptr)
+    {
+        allocFunc = DefaultAlloc;
+        freeFunc = DefaultFree;
+        allocUserData = nullptr;
+        return;
+    }
+    allocFunc = alloc;
+    freeFunc = free;
+    allocUserData = userData;
+}
+
+void *MemHandler::AlignedAlloc(size_t size, size_t alignment)
+{
+    if (size == 0)
+        return nullptr;
+    return allocFunc(size, alignment, allocUserData);
+}
+
+void MemHandler::AlignedFree(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    freeFunc(ptr, allocUserData);
+}
@@ -3,15 +3,28 @@
 
 #include <memory>
 #include <cstring>
+#include <cstddef>
 #if ENABLE_ESP_SUPPORT
 #include "esp_attr.h"
 #endif
 
+// alignment used for locally stored texture rows, one cache line and wide enough for any SIMD load
+#define TEXTURE_ROW_ALIGNMENT 64
+
 namespace Tergos2D
 {
+    /// @brief user supplied allocation hook, has to return memory aligned to alignment
+    using AllocFunc = void *(*)(size_t size, size_t alignment, void *userData);
+    /// @brief user supplied release hook for memory returned by the matching AllocFunc
+    using FreeFunc = void (*)(void *ptr, void *userData);
+
     class MemHandler
     {
     private:
+        static AllocFunc allocFunc;
+        static FreeFunc freeFunc;
+        static void *allocUserData;
+
     public:
         #if ENABLE_ESP_SUPPORT
             static IRAM_ATTR inline void MemCopy(void *_Dst, const void *_Src, size_t _Size)
@@ -24,8 +37,28 @@ namespace Tergos2D
                 std::memcpy(_Dst, _Src, _Size);
             }
         #endif
+
+        /// @brief Replace the allocator used for texture storage, set it before textures are created.
+        /// Passing nullptr for either function restores the default allocator
+        /// @param alloc
+        /// @param free
+        /// @param userData passed through to both hooks
+        static void SetAllocator(AllocFunc alloc, FreeFunc free, void *userData = nullptr);
+
+        /// @brief Allocate size bytes aligned to alignment (power of two) through the current allocator
+        /// @return pointer or nullptr
+        static void *AlignedAlloc(size_t size, size_t alignment = TEXTURE_ROW_ALIGNMENT);
+
+        /// @brief Release memory returned by AlignedAlloc
+        static void AlignedFree(void *ptr);
+
+        /// @brief Round value up to the next multiple of alignment (power of two)
+        static inline size_t AlignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
     };
 
 }
 
-#endif // !MEM_HANDLER_H
\ No newline at end of file
+#endif // !MEM_HANDLER_H
@@ -69,7 +69,7 @@ uint8_t *create_framebuffer(int drm_fd, uint32_t width, uint32_t height, uint32_
     uint8_t *pixels = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, drm_fd, map_dumb.offset);
     CHECK_ERR(pixels == MAP_FAILED, "Failed to mmap dumb buffer");
 
-    CHECK_ERR(drmModeAddFB(drm_fd, width, height, 24, 24, pitch, handle, &fb_id) < 0, "Failed to create framebuffer");
+    CHECK_ERR(drmModeAddFB(drm_fd, width, height, 24, bpp, pitch, handle, &fb_id) < 0, "Failed to create framebuffer");
 
     return pixels;
 }
@@ -182,7 +182,7 @@ int main()
 
     for (int i = 0; i < 2; ++i)
     {
-        framebuffer[i] = create_framebuffer(drm_fd, width, height, 24, fb_id[i], handle[i], pitch[i], size[i]);
+        framebuffer[i] = create_framebuffer(drm_fd, width, height, 32, fb_id[i], handle[i], pitch[i], size[i]);
     }
 
     RenderContext2D context;
@@ -215,26 +215,35 @@ int main()
     data5 = stbi_load("data/images.png", &imgwidth, &imgheight, &nrChannels, 3);
     text5 = Texture(imgwidth, imgheight, data5, PixelFormat::RGB24, 0);
 
-    std::ifstream file("data/testrgb565.bin", std::ios::binary | std::ios::ate);
-    if (file)
+    // prefer the mapped container, the raw .bin needs hard coded dimensions
+    TextureFile rgb565File;
+    if (rgb565File.Open("data/testrgb565.t2d"))
     {
-        std::streamsize size = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        data4 = new uint8_t[size];
-        if (file.read(reinterpret_cast<char *>(data4), size))
+        text4 = rgb565File.GetTexture();
+    }
+    else
+    {
+        std::ifstream file("data/testrgb565.bin", std::ios::binary | std::ios::ate);
+        if (file)
         {
-            text4 = Texture(imgwidth4, imgheight4, data4, PixelFormat::RGB565, 0);
+            std::streamsize size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            data4 = new uint8_t[size];
+            if (file.read(reinterpret_cast<char *>(data4), size))
+            {
+                text4 = Texture(imgwidth4, imgheight4, data4, PixelFormat::RGB565, 0);
+            }
+            else
+            {
+                std::cerr << "Failed to read testrgb565.bin" << std::endl;
+            }
+            file.close();
         }
         else
         {
-            std::cerr << "Failed to read testrgb565.bin" << std::endl;
+            std::cerr << "Failed to open testrgb565.bin" << std::endl;
         }
-        file.close();
-    }
-    else
-    {
-        std::cerr << "Failed to open testrgb565.bin" << std::endl;
     }
     context.EnableClipping(false);
 
@@ -255,7 +264,7 @@ int main()
     {
         int next = 1 - current;
 
-        Texture texture = Texture(width, height, framebuffer[next], PixelFormat::BGR24, pitch[next]);
+        Texture texture = Texture(width, height, framebuffer[next], PixelFormat::BGRX8888, pitch[next]);
         context.SetTargetTexture(&texture);
 
         context.ClearTarget(Color(150, 150, 150));
@@ -1,8 +1,31 @@
 #!/usr/bin/env python3
 
 import sys
+import struct
 from PIL import Image
 
+# .t2d container, layout has to match SoftRendererLib/src/data/TextureFile.h
+T2D_MAGIC = b'T2D1'
+T2D_VERSION = 1
+T2D_HEADER = struct.Struct('<4sHHIIIIIIIIQQQ')  # 64 bytes
+T2D_MIP_LEVEL = struct.Struct('<IIIIQ')         # 24 bytes
+T2D_ATLAS_ENTRY = struct.Struct('<IIII')        # 16 bytes
+
+# PixelFormat enum values and in-memory encoders, 16 bit formats are little endian words
+T2D_FORMATS = {
+    'rgb24': (0, 3, lambda r, g, b, a: bytes((r, g, b))),
+    'bgr24': (1, 3, lambda r, g, b, a: bytes((b, g, r))),
+    'argb8888': (2, 4, lambda r, g, b, a: bytes((a, r, g, b))),
+    'bgra8888': (3, 4, lambda r, g, b, a: bytes((b, g, r, a))),
+    'rgba8888': (4, 4, lambda r, g, b, a: bytes((r, g, b, a))),
+    'argb1555': (5, 2, lambda r, g, b, a: (((1 if a >= 128 else 0) << 15) | ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3)).to_bytes(2, 'little')),
+    'rgb565': (6, 2, lambda r, g, b, a: (((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)).to_bytes(2, 'little')),
+    'rgba4444': (7, 2, lambda r, g, b, a: (((r >> 4) << 12) | ((g >> 4) << 8) | ((b >> 4) << 4) | (a >> 4)).to_bytes(2, 'little')),
+    'grayscale8': (8, 1, lambda r, g, b, a: bytes(((r * 77 + g * 150 + b * 29) >> 8,))),
+    'xrgb8888': (9, 4, lambda r, g, b, a: bytes((255, r, g, b))),
+    'bgrx8888': (10, 4, lambda r, g, b, a: bytes((b, g, r, 255))),
+}
+
 def rgb565_conversion(input_path, output_path):
     try:
         img = Image.open(input_path).convert('RGB')
@@ -117,10 +140,110 @@ def argb1555_conversion(input_path, output_path):
     except Exception as e:
         print(f"An error occurred during ARGB1555 conversion: {e}")
 
+def align_up(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def t2d_encode(img, encoder, bytes_per_pixel, alignment):
+    width, height = img.size
+    pitch = align_up(width * bytes_per_pixel, alignment)
+    padding = bytes(pitch - width * bytes_per_pixel)
+    rows = []
+    pixels = img.load()
+    for y in range(height):
+        row = b''.join(encoder(*pixels[x, y]) for x in range(width))
+        rows.append(row + padding)
+    return pitch, b''.join(rows)
+
+def t2d_shelf_pack(images, padding):
+    # simple shelf packing, tallest first, roughly square page
+    total_area = sum((w + padding) * (h + padding) for w, h in (img.size for img in images))
+    page_width = max(max(img.size[0] for img in images) + padding, int(total_area ** 0.5) + 1)
+    order = sorted(range(len(images)), key=lambda i: -images[i].size[1])
+    rects = [None] * len(images)
+    x = y = shelf_height = 0
+    for i in order:
+        w, h = images[i].size
+        if x + w > page_width:
+            x = 0
+            y += shelf_height + padding
+            shelf_height = 0
+        rects[i] = (x, y, w, h)
+        x += w + padding
+        shelf_height = max(shelf_height, h)
+    page = Image.new('RGBA', (page_width, y + shelf_height), (0, 0, 0, 0))
+    for img, (x, y, w, h) in zip(images, rects):
+        page.paste(img, (x, y))
+    return page, rects
+
+def t2d_conversion(input_paths, output_path, format_name, mips, alignment):
+    try:
+        if format_name not in T2D_FORMATS:
+            raise ValueError(f"unknown pixel format '{format_name}'")
+        format_id, bytes_per_pixel, encoder = T2D_FORMATS[format_name]
+
+        images = [Image.open(path).convert('RGBA') for path in input_paths]
+        atlas = []
+        if len(images) > 1:
+            img, atlas = t2d_shelf_pack(images, 1)
+        else:
+            img = images[0]
+
+        levels = [img]
+        while mips and (levels[-1].size[0] > 1 or levels[-1].size[1] > 1):
+            w, h = levels[-1].size
+            levels.append(levels[-1].resize((max(1, w // 2), max(1, h // 2)), Image.BOX))
+
+        encoded = [t2d_encode(level, encoder, bytes_per_pixel, alignment) for level in levels]
+
+        mip_table_offset = T2D_HEADER.size
+        atlas_table_offset = mip_table_offset + T2D_MIP_LEVEL.size * (len(levels) - 1)
+        offset = align_up(atlas_table_offset + T2D_ATLAS_ENTRY.size * len(atlas), alignment)
+        offsets = []
+        for pitch, data in encoded:
+            offsets.append(offset)
+            offset = align_up(offset + len(data), alignment)
+
+        with open(output_path, 'wb') as f:
+            f.write(T2D_HEADER.pack(T2D_MAGIC, T2D_VERSION, T2D_HEADER.size, format_id,
+                                    img.size[0], img.size[1], encoded[0][0], alignment,
+                                    len(levels) - 1, len(atlas), 0,
+                                    offsets[0], mip_table_offset, atlas_table_offset))
+            for level, (pitch, data), level_offset in list(zip(levels, encoded, offsets))[1:]:
+                f.write(T2D_MIP_LEVEL.pack(level.size[0], level.size[1], pitch, 0, level_offset))
+            for rect in atlas:
+                f.write(T2D_ATLAS_ENTRY.pack(*rect))
+            for (pitch, data), level_offset in zip(encoded, offsets):
+                f.write(bytes(level_offset - f.tell()))
+                f.write(data)
+
+        print(f"T2D container ({format_name}, {len(levels)} level(s), {len(atlas)} atlas entries) saved to: {output_path}")
+
+    except FileNotFoundError as e:
+        print(f"Error: File '{e.filename}' not found.")
+    except Exception as e:
+        print(f"An error occurred during T2D conversion: {e}")
+
 def main():
+    if len(sys.argv) >= 4 and sys.argv[3].lower() == 't2d':
+        args = sys.argv[4:]
+        format_name = 'argb8888'
+        mips = False
+        alignment = 64
+        for arg in args:
+            if arg == '--mips':
+                mips = True
+            elif arg.startswith('--align='):
+                alignment = int(arg.split('=', 1)[1])
+            else:
+                format_name = arg.lower()
+        t2d_conversion(sys.argv[1].split(','), sys.argv[2], format_name, mips, alignment)
+        return
+
     if len(sys.argv) != 4:
         print("Usage: convert_image.py <input_image> <output_file> <format>")
         print("Format options: rgb565, argb8888, grayscale8, grayscale4, argb1555")
+        print("       convert_image.py <input_image[,input_image...]> <output.t2d> t2d [pixelformat] [--mips] [--align=N]")
+        print("       several inputs are packed into one atlas with an atlas table")
         sys.exit(1)
 
     input_path = sys.argv[1]